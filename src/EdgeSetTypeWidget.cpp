@@ -31,9 +31,11 @@ License
 #include <iostream>
 #include "HexBlocker.h"
 #include "HexEdge.h"
+#include "HexEdgeCollection.h"
 #include "HexPatch.h"
+#include "HexPatchCollection.h"
 #include "PointsTableModel.h"
-#include "vtkCollection.h"
+#include "HexCollection.h"
 #include "vtkIdList.h"
 #include "vtkPoints.h"
 
@@ -66,8 +68,8 @@ EdgeSetTypeWidget::EdgeSetTypeWidget(QWidget *parent) :
         SIGNAL(selectionChanged(QItemSelection,QItemSelection)),
         this, SIGNAL(selectionChanged(QItemSelection)));
 
-    connect(table,SIGNAL(pointEdited()),
-            this,SLOT(slotDataChanged()));
+    connect(table,SIGNAL(pointEdited(vtkIdType,double,double,double)),
+            this,SLOT(slotControlPointEdited(vtkIdType,double,double,double)));
     connect(ui->pushButtonApply,SIGNAL(clicked()),this,SLOT(slotApply()));
     connect(ui->selectPatchPushButton,SIGNAL(clicked()),
             this,SIGNAL(startSelectPatch()));
@@ -95,9 +97,7 @@ void EdgeSetTypeWidget::setSelectedEdge(vtkIdType selEdgeId)
     selectedEdge = HexEdge::SafeDownCast(
                 hexBlocker->edges->GetItemAsObject(selectedEdgeId));
 
-    vtkIdList * cntrlPoints = selectedEdge->cntrlPointsIds.GetPointer();
-    vtkPoints * points = selectedEdge->myPoints;
-    table->setPoints(points,cntrlPoints);
+    table->setPoints(selectedEdge->cntrlPoints);
 
     this->ui->typeComboBox->setCurrentIndex(selectedEdge->getType());
     this->slotTypeChanged(); //so buttons are updated.
@@ -128,11 +128,19 @@ void EdgeSetTypeWidget::slotTypeChanged()
         ui->useRadiusCheckBox->setEnabled(true);
         break;
     }
-    selectedEdge->setType(type);
+    hexBlocker->setEdgeType(selectedEdge,type);
     table->update();
 //    this->setSelectedEdge(selectedEdgeId);
 }
 
+void EdgeSetTypeWidget::slotControlPointEdited(vtkIdType id, double x, double y, double z)
+{
+    //an arc has only one control point, id is ignored
+    double pos[3]={x,y,z};
+    hexBlocker->setArcControlPoint(selectedEdge,pos);
+    table->update();
+}
+
 void EdgeSetTypeWidget::slotDataChanged()
 {
     selectedEdge->redrawedge();
@@ -166,15 +174,14 @@ void EdgeSetTypeWidget::setSelectedPatch(vtkIdType selPatchId)
             emit setStatusText(tr(msg));
             return;
         }
-        selectedEdge->calcArcControlPointFromCenter(c,R);
+        hexBlocker->setArcFromCenter(selectedEdge,c,R);
     }
     else
     {
-        selectedEdge->calcArcControlPointFromCenter(c);
+        hexBlocker->setArcFromCenter(selectedEdge,c);
     }
 //    selectedEdge->getControlPoint(0,c);
     table->update();
-    slotDataChanged();
 }
 
 void EdgeSetTypeWidget::slotUseRadiusToggled()
@@ -63,6 +63,7 @@ public slots:
     void slotApply();
     void slotTypeChanged();
     void slotDataChanged();
+    void slotControlPointEdited(vtkIdType id, double x, double y, double z);
     void slotUseRadiusToggled();
 
 
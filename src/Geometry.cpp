@@ -24,42 +24,47 @@ License
 
 
 #include "HexBlocker.h"
-#include "ui_MainWindow.h"
+#include "HexVertexLocator.h"
+#include "HexUndoStack.h"
+#include "HexCollection.h"
+#include "HexGeometry.h"
+#include "HexSurfaceLocator.h"
+#include "HexEdge.h"
+#include "HexEdgeCollection.h"
 
-#include <vtkPolyData.h>
-#include <vtkSTLReader.h>
 #include <vtkSmartPointer.h>
-#include <vtkPolyDataMapper.h>
-#include <vtkProperty.h>
-#include <vtkActor.h>
-#include <vtkRenderer.h>
-#include <vtkTransform.h>
-#include <vtkCellLocator.h>
+#include <vtkMath.h>
 #include <vtkIdList.h>
-#include <vtkIdFilter.h>
 
-#include <QtGui>
-#include <QMainWindow>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <iostream>
 
-void HexBlocker::readGeometry(char* openFileName)
+bool HexBlocker::readGeometry(char* openFileName)
 {
     printf("reading: %s\n", openFileName);
 
-//  vtkSmartPointer<vtkSTLReader> GeoReader = vtkSmartPointer<vtkSTLReader>::New();
-    GeoReader = vtkSmartPointer<vtkSTLReader>::New();
-    GeoReader->SetFileName(openFileName);
-    GeoReader->Update();
-
-    vtkSmartPointer<vtkPolyDataMapper> GeoMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    GeoMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    GeoMapper->SetInputConnection(GeoReader->GetOutputPort());
-
-    GeoActor->GetProperty()->SetOpacity(0.5);
-    GeoActor->SetMapper(GeoMapper);
+    //added to the geometries already read
+    vtkSmartPointer<HexGeometry> geo = vtkSmartPointer<HexGeometry>::New();
+    if(!geo->read(openFileName))
+    {
+        std::cout << "could not read a geometry from " << openFileName << std::endl;
+        return false;
+    }
+    geo->setFeatureAngle(featureAngle);
+    geometries->AddItem(geo);
+    this->render();
+    return true;
+}
 
-    renderer->AddActor(GeoActor);
-    geoScale = 1.0;
-    hasGeometry = true;
+void HexBlocker::removeGeometry(vtkIdType geoId)
+{
+    HexGeometry *geo = HexGeometry::SafeDownCast(geometries->GetItemAsObject(geoId));
+    if(geo == NULL)
+        return;
+    geometries->RemoveItem(geoId);
+    this->render();
 }
 
 void HexBlocker::showGeometry()
@@ -74,7 +79,15 @@ void HexBlocker::hideGeometry()
 
 void HexBlocker::visibilityGeometry(bool mode)
 {
-    GeoActor->SetVisibility(mode);
+    for(vtkIdType i=0;i<geometries->GetNumberOfItems();i++)
+        visibilityGeometry(i,mode);
+}
+
+void HexBlocker::visibilityGeometry(vtkIdType geoId, bool mode)
+{
+    HexGeometry *geo = HexGeometry::SafeDownCast(geometries->GetItemAsObject(geoId));
+    if(geo != NULL)
+        geo->setVisibility(mode);
 }
 
 void HexBlocker::setModelScale(double scale)
@@ -82,52 +95,164 @@ void HexBlocker::setModelScale(double scale)
     convertToMeters = scale;
 }
 
+void HexBlocker::setMergeTolerance(double tol)
+{
+    vertLocator->setTolerance(tol);
+}
+
+double HexBlocker::getMergeTolerance()
+{
+    return vertLocator->getTolerance();
+}
+
 void HexBlocker::scaleGeometry(double scale)
 {
-    if(!hasGeometry) return;
     if(scale <= 0) return;
     geoScale = scale;
-    vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
-    transform->Scale(scale, scale, scale);
-    GeoActor->SetUserTransform(transform);
+    for(vtkIdType i=0;i<geometries->GetNumberOfItems();i++)
+        HexGeometry::SafeDownCast(geometries->GetItemAsObject(i))->setScale(scale);
     this->render();
 }
 
-void HexBlocker::snapVertices(vtkSmartPointer<vtkIdList> ids)
+void HexBlocker::scaleGeometry(vtkIdType geoId, double scale)
+{
+    HexGeometry *geo = HexGeometry::SafeDownCast(geometries->GetItemAsObject(geoId));
+    if(geo == NULL || scale <= 0)
+        return;
+    geo->setScale(scale);
+    this->render();
+}
+
+//the progress of one geometry as part of all, see findClosestOnGeometries
+struct HexSnapProgress
+{
+    bool (*progress)(double, void *);
+    void *clientData;
+    int done;
+    int total;
+};
+
+static bool snapProgress(double fraction, void *arg)
+{
+    HexSnapProgress *p = static_cast<HexSnapProgress *>(arg);
+    return p->progress((p->done+fraction)/p->total,p->clientData);
+}
+
+vtkIdType HexBlocker::findClosestOnGeometries(vtkIdType n, const double *pos, double *closest,
+                                              vtkIdType geoId, bool features,
+                                              bool (*progress)(double, void *), void *clientData)
 {
-    if(!hasGeometry) return;
-    vtkSmartPointer<vtkTransform> transform1 = vtkSmartPointer<vtkTransform>::New();
-    vtkSmartPointer<vtkTransform> transform2 = vtkSmartPointer<vtkTransform>::New();
-    transform1->Scale(geoScale, geoScale, geoScale);
-    transform2->Scale(1/geoScale, 1/geoScale, 1/geoScale);
-    vtkSmartPointer<vtkIdFilter> cellIdFilter =
-        vtkSmartPointer<vtkIdFilter>::New();
-    cellIdFilter->SetInputConnection(GeoReader->GetOutputPort());
-    cellIdFilter->Update();
+    vtkIdType numGeos = geometries->GetNumberOfItems();
+    if(n == 0 || numGeos == 0 || geoId >= numGeos)
+        return 0;
 
-    vtkSmartPointer<vtkCellLocator> cellLocator = vtkSmartPointer<vtkCellLocator>::New();
-    cellLocator->SetDataSet(cellIdFilter->GetOutput());
-    cellLocator->BuildLocator();
+    //one geometry or all of them
+    vtkIdType first = geoId < 0 ? 0 : geoId;
+    vtkIdType last = geoId < 0 ? numGeos : geoId+1;
 
-    for(vtkIdType i=0; i<ids->GetNumberOfIds(); i++)
+    std::vector<double> found(3*n);
+    std::vector<double> dist2(n,VTK_DOUBLE_MAX);
+    HexSnapProgress sp = {progress, clientData, 0, int(last-first)};
+    vtkIdType searched = 0;
+    for(vtkIdType g=first; g<last; g++,sp.done++)
     {
-        //Find the closest points to TestPoint
-        double pos[3];              //the coordinates of the vertice to move
-        double *scaledPos;          //scaled coordinates
-        double closestPoint[3];     //the coordinates of the closest point will be returned here
-        double closestPointDist2;   //the squared distance to the closest point will be returned here
-        vtkIdType cellId;           //the cell id of the cell containing the closest point will be returned here
-        int subId;                  //this is rarely used (in triangle strips only, I believe)
-
-        vertices->GetPoint(ids->GetId(i),pos);
-        scaledPos = transform2->TransformPoint(pos);
-        cellLocator->FindClosestPoint(scaledPos, closestPoint, cellId, subId, closestPointDist2);
-        scaledPos = transform1->TransformPoint(closestPoint);
-        pos[0] = scaledPos[0];
-        pos[1] = scaledPos[1];
-        pos[2] = scaledPos[2];
-        vertices->SetPoint(ids->GetId(i),pos);
+        HexGeometry *geo = HexGeometry::SafeDownCast(geometries->GetItemAsObject(g));
+        HexSurfaceLocator *loc = features ? geo->getFeatureLocator() : geo->locator.GetPointer();
+        //waiting for a locator to be built may take a while too
+        if(progress != NULL && !snapProgress(0.0,&sp))
+            return -1; //cancelled
+        if(loc->isEmpty())
+            continue; //nothing to search, not cancelled
+        if(!loc->findClosestPoints(n,pos,&found[0],
+                                   progress ? snapProgress : NULL,&sp))
+            return -1; //cancelled
+
+        //keep the closest of all geometries
+        for(vtkIdType i=0; i<n; i++)
+        {
+            double d2 = vtkMath::Distance2BetweenPoints(&pos[3*i],&found[3*i]);
+            if(d2 < dist2[i])
+            {
+                dist2[i] = d2;
+                std::copy(&found[3*i],&found[3*i]+3,&closest[3*i]);
+            }
+        }
+        searched++;
     }
+    return searched;
+}
+
+bool HexBlocker::snapVertices(vtkSmartPointer<vtkIdList> ids, vtkIdType geoId,
+                              bool (*progress)(double, void *), void *clientData)
+{
+    return snapVerticesTo(ids,geoId,false,progress,clientData);
+}
+
+bool HexBlocker::snapVerticesToFeatures(vtkSmartPointer<vtkIdList> ids, vtkIdType geoId,
+                                        bool (*progress)(double, void *), void *clientData)
+{
+    return snapVerticesTo(ids,geoId,true,progress,clientData);
+}
+
+bool HexBlocker::snapVerticesTo(vtkSmartPointer<vtkIdList> ids, vtkIdType geoId, bool features,
+                                bool (*progress)(double, void *), void *clientData)
+{
+    vtkIdType n = ids->GetNumberOfIds();
+    std::vector<double> pos(3*n), closest(3*n);
+    for(vtkIdType i=0; i<n; i++)
+        vertices->GetPoint(ids->GetId(i),&pos[3*i]);
+
+    vtkIdType searched = findClosestOnGeometries(n,&pos[0],&closest[0],geoId,features,
+                                                 progress,clientData);
+    if(searched < 0)
+        return false; //cancelled
+    if(searched == 0)
+        return true;
+
+    HexUndoStep step(undoStack,features ? "snap vertices to features" : "snap vertices");
+    for(vtkIdType i=0; i<n; i++)
+        setVertice(ids->GetId(i),&closest[3*i]);
     vertices->Modified();
-    rescaleActors();
+    redrawMovedVertices();
+    return true;
+}
+
+void HexBlocker::snapArcsToFeatures(vtkIdList *edgeIds, vtkIdType geoId)
+{
+    //the control points of the arcs, lines have none
+    std::vector<HexEdge *> arcs;
+    std::vector<double> pos;
+    for(vtkIdType i=0; i<edgeIds->GetNumberOfIds(); i++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(edgeIds->GetId(i)));
+        if(e == NULL || e->getType() != HexEdge::ARC)
+            continue;
+        double p[3];
+        e->getControlPoint(0,p);
+        arcs.push_back(e);
+        pos.insert(pos.end(),p,p+3);
+    }
+    vtkIdType n = arcs.size();
+    if(n == 0)
+        return;
+
+    std::vector<double> closest(3*n);
+    if(findClosestOnGeometries(n,&pos[0],&closest[0],geoId,true) <= 0)
+        return;
+
+    HexUndoStep step(undoStack,"snap arcs to features");
+    for(vtkIdType i=0; i<n; i++)
+    {
+        undoStack->arcChanged(arcs[i]);
+        arcs[i]->setControlPoint(0,&closest[3*i]);
+        arcs[i]->redrawedge();
+    }
+    this->render();
+}
+
+void HexBlocker::setFeatureAngle(double angle)
+{
+    featureAngle = angle;
+    for(vtkIdType i=0;i<geometries->GetNumberOfItems();i++)
+        HexGeometry::SafeDownCast(geometries->GetItemAsObject(i))->setFeatureAngle(angle);
 }
@@ -0,0 +1,146 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexAxesRepresentation.h"
+#include "HexBlock.h"
+#include "HexCollection.h"
+#include "HexDirtyItems.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkActor.h>
+#include <vtkProperty.h>
+
+vtkStandardNewMacro(HexAxesRepresentation);
+
+HexAxesRepresentation::HexAxesRepresentation()
+{
+    dirty = vtkSmartPointer<HexDirtyItems>::New();
+    points = vtkSmartPointer<vtkPoints>::New();
+    data = vtkSmartPointer<vtkPolyData>::New();
+    data->SetPoints(points);
+
+    mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+#if VTK_MAJOR_VERSION >= 6
+    mapper->SetInputData(data);
+#else
+    mapper->SetInput(data);
+#endif
+    mapper->SetScalarModeToUseCellData();
+
+    actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetMapper(mapper);
+    actor->GetProperty()->SetLineWidth(3);
+    actor->SetPickable(false);
+}
+
+HexAxesRepresentation::~HexAxesRepresentation()
+{
+
+}
+
+void HexAxesRepresentation::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "axes: " << data->GetNumberOfCells() << std::endl;
+}
+
+void HexAxesRepresentation::setBlocks(HexCollection *blockList, vtkPoints *verts)
+{
+    blocks = blockList;
+    vertices = verts;
+    this->Modified();
+}
+
+void HexAxesRepresentation::update()
+{
+    if(blocks == NULL)
+        return;
+
+    if(blocks->GetMTime() > buildTime || this->GetMTime() > buildTime)
+    {
+        rebuild();
+        return;
+    }
+
+    std::vector<vtkIdType> ids;
+    dirty->takeDirty(ids);
+    for(size_t i=0;i<ids.size();i++)
+        setAxesPoints(ids[i],HexBlock::SafeDownCast(blocks->GetItemAsObject(ids[i])));
+    if(!ids.empty())
+        points->Modified();
+}
+
+void HexAxesRepresentation::rebuild()
+{
+    dirty->watch(blocks);
+    vtkIdType numBlocks = blocks->GetNumberOfItems();
+    points->SetNumberOfPoints(4*numBlocks);
+
+    //red, green and blue for the x, y and z axes
+    vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkUnsignedCharArray> colors =
+            vtkSmartPointer<vtkUnsignedCharArray>::New();
+    colors->SetNumberOfComponents(3);
+    colors->SetNumberOfTuples(3*numBlocks);
+    for(vtkIdType i=0;i<numBlocks;i++)
+    {
+        setAxesPoints(i,HexBlock::SafeDownCast(blocks->GetItemAsObject(i)));
+        for(vtkIdType k=0;k<3;k++)
+        {
+            vtkIdType line[2] = {4*i, 4*i+k+1};
+            lines->InsertNextCell(2,line);
+            for(int c=0;c<3;c++)
+                colors->SetValue(3*(3*i+k)+c, c == k ? 255 : 0);
+        }
+    }
+
+    data->SetLines(lines);
+    data->GetCellData()->SetScalars(colors);
+    points->Modified();
+    data->Modified();
+    buildTime.Modified();
+}
+
+void HexAxesRepresentation::setAxesPoints(vtkIdType i, HexBlock *hb)
+{
+    //scaled by 0.4 towards the first vertice
+    static const vtkIdType ends[3] = {1, 3, 4};
+    double origin[3], end[3];
+    vertices->GetPoint(hb->vertIds->GetId(0),origin);
+    points->SetPoint(4*i,origin);
+    for(int k=0;k<3;k++)
+    {
+        vertices->GetPoint(hb->vertIds->GetId(ends[k]),end);
+        for(int d=0;d<3;d++)
+            end[d] = origin[d] + 0.4*(end[d]-origin[d]);
+        points->SetPoint(4*i+k+1,end);
+    }
+}
@@ -0,0 +1,91 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Draws the local axes of all blocks, the little red, green and blue
+    lines from the first vertice of a block towards vertices 1, 3 and 4,
+    at 0.4 of the edge length. The axes of all blocks are lines in one
+    polydata drawn with a line width, so a moved block only changes its
+    own four points (see HexDirtyItems). The lines are rebuilt when blocks are added or
+    removed.
+*/
+
+#ifndef HEXAXESREPRESENTATION_H
+#define HEXAXESREPRESENTATION_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+class HexBlock;
+class HexCollection;
+class HexDirtyItems;
+class vtkPoints;
+class vtkPolyData;
+class vtkPolyDataMapper;
+class vtkActor;
+
+class HexAxesRepresentation : public vtkObject
+{
+    vtkTypeMacro(HexAxesRepresentation,vtkObject)
+
+protected:
+    HexAxesRepresentation();
+    ~HexAxesRepresentation();
+    HexAxesRepresentation(const HexAxesRepresentation&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexAxesRepresentation&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexAxesRepresentation *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the blocks to draw the axes of and the vertices they refer to
+    void setBlocks(HexCollection *blockList, vtkPoints *verts);
+
+    //brings the axes up to date with the blocks, only the blocks
+    //that have changed since the last call are redone.
+    void update();
+
+    //DATA
+    vtkSmartPointer<vtkActor> actor;
+
+private:
+    //FUNCTIONS
+    //recreates the axes of all blocks
+    void rebuild();
+    //the four points of the axes of block i
+    void setAxesPoints(vtkIdType i, HexBlock *hb);
+
+    //DATA
+    vtkSmartPointer<HexCollection> blocks;
+    vtkSmartPointer<vtkPoints> vertices;
+    vtkSmartPointer<HexDirtyItems> dirty;
+    vtkSmartPointer<vtkPoints> points;
+    vtkSmartPointer<vtkPolyData> data;
+    vtkSmartPointer<vtkPolyDataMapper> mapper;
+    vtkTimeStamp buildTime;
+};
+
+#endif // HEXAXESREPRESENTATION_H
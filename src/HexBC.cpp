@@ -26,8 +26,9 @@ License
 
 #include <vtkObjectFactory.h>
 #include <vtkIdList.h>
-#include <vtkCollection.h>
+#include "HexCollection.h"
 #include <HexPatch.h>
+#include "HexPatchCollection.h"
 
 
 vtkStandardNewMacro(HexBC);
@@ -37,8 +38,8 @@ HexBC::HexBC()
 {
     name = std::string("DefaultPatches");
     type = std::string("patch");
-    globalPatches = vtkSmartPointer<vtkCollection>::New();
-    localPatches = vtkSmartPointer<vtkCollection>::New();
+    globalPatches = vtkSmartPointer<HexPatchCollection>::New();
+    localPatches = vtkSmartPointer<HexCollection>::New();
     //delete name;
     //name = new QString("foo");
 }
@@ -76,19 +77,12 @@ void HexBC::PrintSelf(ostream &os, vtkIndent indent)
 
 bool HexBC::insertPatchIfIdsExists(vtkSmartPointer<vtkIdList> ids)
 {
-
-    bool foundIt=false;
-    for(vtkIdType i=0;i<globalPatches->GetNumberOfItems();i++)
-    {
-        HexPatch * p = HexPatch::SafeDownCast(globalPatches->GetItemAsObject(i));
-        if(p->equals(ids))
-        {
-            localPatches->AddItem(p);
-            foundIt=true;
-        }
-    }
-
-    return foundIt;
+    //every patch with these vertices, as when all were compared
+    std::vector<HexPatch *> found;
+    globalPatches->findPatches(ids,found);
+    for(size_t i=0;i<found.size();i++)
+        localPatches->AddItem(found[i]);
+    return !found.empty();
 }
 
 void HexBC::insertPatches(vtkIdList *pids)
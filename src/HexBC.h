@@ -23,7 +23,7 @@ License
     The license is included in the file COPYING.
 
 Description
-    This class contains a list (vtkCollection) of which patches are included
+    This class contains a list (HexCollection) of which patches are included
     for each defined boundary condition.
 */
 
@@ -38,8 +38,9 @@ Description
 
 //Pre declarations
 class vtkIdList;
-class vtkCollection;
+class HexCollection;
 class HexPatch;
+class HexPatchCollection;
 
 
 
@@ -81,8 +82,8 @@ public:
     void insertPatches(vtkIdList *pids);
 
     void getLocalPatchesIdsInGlobal(vtkIdList *idsInGlobal);
-    vtkSmartPointer<vtkCollection> globalPatches; //All patches in the model
-    vtkSmartPointer<vtkCollection> localPatches; //All patches in the model
+    vtkSmartPointer<HexPatchCollection> globalPatches; //All patches in the model
+    vtkSmartPointer<HexCollection> localPatches; //All patches in the model
     //DATA
     std::string name;
     std::string type; //e.g. wall or patch
@@ -0,0 +1,286 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexBatch.h"
+#include "HexBlocker.h"
+#include "HexEdge.h"
+#include "HexCollection.h"
+#include "HexEdgeCollection.h"
+#include "HexPatchCollection.h"
+#include "HexReader.h"
+#include "HexExporter.h"
+
+#include <vtkSmartPointer.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+
+#include <QFile>
+#include <QTextStream>
+#include <QRegExp>
+#include <iostream>
+
+HexBatch::HexBatch()
+{
+    hexBlocker = new HexBlocker();
+}
+
+HexBatch::~HexBatch()
+{
+    delete hexBlocker;
+}
+
+int HexBatch::run(QTextStream &script, const QStringList &args)
+{
+    int lineNum = 0;
+    while(!script.atEnd())
+    {
+        QString line = script.readLine();
+        lineNum++;
+        int hash = line.indexOf('#');
+        if(hash >= 0)
+            line = line.left(hash);
+        //backwards so that $1 doesn't eat the start of $10
+        for(int i=args.size();i>0;i--)
+            line.replace(QString("$%1").arg(i),args.at(i-1));
+
+        QStringList words = line.split(QRegExp("\\s+"),QString::SkipEmptyParts);
+        if(words.isEmpty())
+            continue;
+        if(!runCommand(words))
+        {
+            std::cerr << "batch: error on line " << lineNum << ": "
+                      << line.simplified().toAscii().data() << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+bool HexBatch::runCommand(const QStringList &words)
+{
+    QString cmd = words.at(0);
+    double vals[7];
+    if(cmd == "read" && words.size() == 2)
+        return readDict(words.at(1));
+    if(cmd == "write" && words.size() == 2)
+        return writeDict(words.at(1));
+    if(cmd == "scale")
+    {
+        if(!toDoubles(words,1,1,vals) || vals[0] <= 0)
+            return false;
+        hexBlocker->setModelScale(vals[0]);
+        return true;
+    }
+    if(cmd == "tolerance")
+    {
+        if(!toDoubles(words,1,1,vals) || vals[0] < 0)
+            return false;
+        hexBlocker->setMergeTolerance(vals[0]);
+        return true;
+    }
+    if(cmd == "move")
+    {
+        vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+        if(!toDoubles(words,1,3,vals) || !toIds(words,4,ids))
+            return false;
+        hexBlocker->moveVertices(ids,vals);
+        return true;
+    }
+    if(cmd == "rotate")
+    {
+        vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+        if(!toDoubles(words,1,7,vals) || !toIds(words,8,ids))
+            return false;
+        hexBlocker->rotateVertices(ids,vals[0],&vals[1],&vals[4]);
+        return true;
+    }
+    if(cmd == "cells" && (words.size() == 4 || words.size() == 5))
+    {
+        vtkIdType edgeId = findEdge(words,1);
+        bool ok;
+        int nCells = words.at(3).toInt(&ok);
+        if(edgeId < 0 || !ok || nCells < 1)
+            return false;
+        HexEdge *e = HexEdge::SafeDownCast(
+                    hexBlocker->edges->GetItemAsObject(edgeId));
+        vtkSmartPointer<HexEdge> props = vtkSmartPointer<HexEdge>::New();
+        props->nCells = nCells;
+        props->grading = e->grading;
+        //without a grading only the number of cells is propagated
+        int mode = 1;
+        if(words.size() == 5)
+        {
+            if(!toDoubles(words,4,1,vals))
+                return false;
+            props->grading = vals[0];
+            mode = 0;
+        }
+        hexBlocker->setEdgePropsOnParallelEdges(props,edgeId,mode);
+        return true;
+    }
+    if(cmd == "extrude" && words.size() == 6)
+    {
+        vtkIdType patchId = findPatch(words,1);
+        if(patchId < 0 || !toDoubles(words,5,1,vals))
+            return false;
+        vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+        ids->InsertNextId(patchId);
+        hexBlocker->extrudePatch(ids,vals[0]);
+        return true;
+    }
+    if(cmd == "split" && words.size() == 3)
+    {
+        vtkIdType edgeId = findEdge(words,1);
+        if(edgeId < 0)
+            return false;
+        hexBlocker->splitHexBlock(edgeId);
+        return true;
+    }
+    if(cmd == "merge" && words.size() == 9)
+    {
+        vtkIdType masterId = findPatch(words,1);
+        vtkIdType slaveId = findPatch(words,5);
+        if(masterId < 0 || slaveId < 0)
+            return false;
+        hexBlocker->mergePatch(masterId,slaveId);
+        return true;
+    }
+    if(cmd == "undo" && words.size() == 1)
+        return hexBlocker->undo();
+    if(cmd == "redo" && words.size() == 1)
+        return hexBlocker->redo();
+    std::cerr << "batch: unknown command or wrong number of arguments" << std::endl;
+    return false;
+}
+
+bool HexBatch::readDict(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        std::cerr << "batch: error opening " << fileName.toAscii().data() << std::endl;
+        return false;
+    }
+    QTextStream in(&file);
+    HexReader reader;
+    int err = reader.readBlockMeshDict(&in);
+    file.close();
+    //a malformed dict must not go on as an empty or partial model
+    if(err != 0 || reader.readVertices->GetNumberOfPoints() == 0 ||
+            reader.readBlocks->GetNumberOfItems() == 0)
+    {
+        std::cerr << "batch: could not read vertices and blocks from "
+                  << fileName.toAscii().data() << std::endl;
+        return false;
+    }
+
+    //start over with a clean model, as when opening in the gui
+    delete hexBlocker;
+    hexBlocker = new HexBlocker();
+    hexBlocker->setModelScale(reader.convertToMeters);
+    hexBlocker->readBlockMeshDict(&reader);
+    hexBlocker->edgesDict = reader.edgesDict;
+    return true;
+}
+
+bool HexBatch::writeDict(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        std::cerr << "batch: error opening " << fileName.toAscii().data() << std::endl;
+        return false;
+    }
+    QTextStream out(&file);
+    HexExporter exporter(hexBlocker);
+    exporter.exporBlockMeshDict(out);
+    out.flush();
+    file.close();
+    return true;
+}
+
+bool HexBatch::toDoubles(const QStringList &words, int from, int n, double *vals)
+{
+    if(words.size() < from+n)
+        return false;
+    for(int i=0;i<n;i++)
+    {
+        bool ok;
+        vals[i] = words.at(from+i).toDouble(&ok);
+        if(!ok)
+            return false;
+    }
+    return true;
+}
+
+bool HexBatch::toIds(const QStringList &words, int from, vtkIdList *ids)
+{
+    vtkIdType numVerts = hexBlocker->vertices->GetNumberOfPoints();
+    for(int i=from;i<words.size();i++)
+    {
+        QStringList range = words.at(i).split('-');
+        bool ok1, ok2 = true;
+        vtkIdType first = range.at(0).toLongLong(&ok1);
+        vtkIdType last = first;
+        if(range.size() == 2)
+            last = range.at(1).toLongLong(&ok2);
+        if(range.size() > 2 || !ok1 || !ok2 || first < 0 || last < first
+                || last >= numVerts)
+        {
+            std::cerr << "batch: bad vertice id " << words.at(i).toAscii().data()
+                      << std::endl;
+            return false;
+        }
+        for(vtkIdType id=first;id<=last;id++)
+            ids->InsertUniqueId(id);
+    }
+    return ids->GetNumberOfIds() > 0;
+}
+
+vtkIdType HexBatch::findEdge(const QStringList &words, int from)
+{
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    if(words.size() < from+2 || !toIds(words.mid(from,2),0,ids)
+            || ids->GetNumberOfIds() != 2)
+        return -1;
+    vtkIdType edgeId = hexBlocker->edges->findEdgeId(ids->GetId(0),ids->GetId(1));
+    if(edgeId < 0)
+        std::cerr << "batch: no edge between vertices "
+                  << ids->GetId(0) << " and " << ids->GetId(1) << std::endl;
+    return edgeId;
+}
+
+vtkIdType HexBatch::findPatch(const QStringList &words, int from)
+{
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    if(words.size() < from+4 || !toIds(words.mid(from,4),0,ids)
+            || ids->GetNumberOfIds() != 4)
+        return -1;
+    vtkIdType patchId = hexBlocker->patches->findPatchId(ids);
+    if(patchId < 0)
+        std::cerr << "batch: no patch with vertices "
+                  << words.mid(from,4).join(" ").toAscii().data() << std::endl;
+    return patchId;
+}
@@ -0,0 +1,86 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Runs a script of model operations without any window, e.g.
+    hexBlocker -batch script.txt [args]. Each line is one command and
+    everything after # is a comment; $1, $2, ... are replaced by the
+    arguments after the script name. Vertice ids are the ids in the
+    model when the command runs; remember that merge removes vertices.
+
+    read FILE                       read a blockMeshDict
+    write FILE                      export a blockMeshDict
+    scale S                         set convertToMeters
+    tolerance T                     merge tolerance for new vertices
+    move DX DY DZ IDS               move vertices
+    rotate A CX CY CZ AX AY AZ IDS  rotate vertices A degrees around an axis
+    cells A B N [G]                 nCells (and grading) on the edge A-B
+                                    and its parallel edges
+    extrude A B C D DIST            extrude the patch with vertices A B C D
+    split A B                       split the blocks parallel to edge A-B
+    merge M0 M1 M2 M3 S0 S1 S2 S3   merge patch S into patch M
+    undo, redo                      undo/redo the last change
+
+    IDS is a list of vertice ids where a range can be given as 4-7.
+*/
+
+#ifndef HEXBATCH_H
+#define HEXBATCH_H
+
+#include <QString>
+#include <QStringList>
+
+class HexBlocker;
+class QTextStream;
+class vtkIdList;
+
+class HexBatch
+{
+public:
+    HexBatch();
+    ~HexBatch();
+
+    //FUNCTIONS
+    //runs all commands in script. Returns 0 on success or 1 if a
+    //command failed, the line is then printed to std::cerr.
+    int run(QTextStream &script, const QStringList &args);
+
+    //runs one command split in words, false on error
+    bool runCommand(const QStringList &words);
+
+    //DATA
+    HexBlocker *hexBlocker;
+
+private:
+    bool readDict(const QString &fileName);
+    bool writeDict(const QString &fileName);
+    //the number of words and the numbers in them are checked
+    bool toDoubles(const QStringList &words, int from, int n, double *vals);
+    bool toIds(const QStringList &words, int from, vtkIdList *ids);
+    // returns id if found else -1, errors are printed
+    vtkIdType findEdge(const QStringList &words, int from);
+    vtkIdType findPatch(const QStringList &words, int from);
+};
+
+#endif // HEXBATCH_H
@@ -28,6 +28,10 @@ License
 
 #include "HexPatch.h"
 #include "HexEdge.h"
+#include "HexCollection.h"
+#include "HexEdgeCollection.h"
+#include "HexPatchCollection.h"
+#include "HexVertexLocator.h"
 
 
 #include <vtkMath.h>
@@ -35,17 +39,6 @@ License
 #include <vtkIdList.h>
 #include <vtkPolyData.h>
 
-#include <vtkPolyDataMapper.h>
-#include <vtkActor.h>
-#include <vtkCollection.h>
-#include <vtkCellArray.h>
-#include <vtkCellData.h>
-#include <vtkLine.h>
-#include <vtkProperty.h>
-#include <vtkTubeFilter.h>
-#include <vtkHexahedron.h>
-#include <vtkUnstructuredGrid.h>
-#include <vtkDataSetMapper.h>
 
 vtkStandardNewMacro(HexBlock);
 
@@ -53,16 +46,14 @@ vtkStandardNewMacro(HexBlock);
 HexBlock::HexBlock()
 {
     vertIds = vtkSmartPointer<vtkIdList>::New();
-    localEdges = vtkSmartPointer<vtkCollection>::New();
-    localPatches = vtkSmartPointer<vtkCollection>::New();
+    localEdges = vtkSmartPointer<HexCollection>::New();
+    localPatches = vtkSmartPointer<HexCollection>::New();
 
     hexData = vtkSmartPointer<vtkPolyData>::New();
-    axesTubes = vtkSmartPointer<vtkTubeFilter>::New();
-    globalEdges = vtkSmartPointer<vtkCollection>::New();
-    globalPatches = vtkSmartPointer<vtkCollection>::New();
-
-    hexAxisActor = vtkSmartPointer<vtkActor>::New();
-    hexBlockActor = vtkSmartPointer<vtkActor>::New();
+    globalEdges = vtkSmartPointer<HexEdgeCollection>::New();
+    globalPatches = vtkSmartPointer<HexPatchCollection>::New();
+    visible = true;
+    resetColor();
 }
 
 HexBlock::~HexBlock()
@@ -71,9 +62,9 @@ HexBlock::~HexBlock()
 }
 
 void HexBlock::init(double corner0[3], double corner1[3],
-                    vtkSmartPointer<vtkPoints> verts,
-                    vtkSmartPointer<vtkCollection> edges,
-                    vtkSmartPointer<vtkCollection> patches)
+                    HexVertexLocator *vertLocator,
+                    vtkSmartPointer<HexEdgeCollection> edges,
+                    vtkSmartPointer<HexPatchCollection> patches)
 {
 
 
@@ -84,34 +75,25 @@ void HexBlock::init(double corner0[3], double corner1[3],
     double y1=corner1[1];
     double z1=corner1[2];
 
-    globalVertices = verts;
+    globalVertices = vertLocator->getPoints();
     globalEdges = edges;
     globalPatches = patches;
 
-    vtkIdType j = globalVertices->GetNumberOfPoints();
-
-    globalVertices->InsertNextPoint(x0,y0,z0);
-    globalVertices->InsertNextPoint(x1,y0,z0);
-    globalVertices->InsertNextPoint(x1,y1,z0);
-    globalVertices->InsertNextPoint(x0,y1,z0);
-    globalVertices->InsertNextPoint(x0,y0,z1);
-    globalVertices->InsertNextPoint(x1,y0,z1);
-    globalVertices->InsertNextPoint(x1,y1,z1);
-    globalVertices->InsertNextPoint(x0,y1,z1);
-
+    double corners[8][3] = {{x0,y0,z0},{x1,y0,z0},{x1,y1,z0},{x0,y1,z0},
+                            {x0,y0,z1},{x1,y0,z1},{x1,y1,z1},{x0,y1,z1}};
 
-    //set global Ids
+    //set global Ids, a corner on an existing vertice shares it
     vertIds->SetNumberOfIds(8);
     for(vtkIdType i=0;i<8;i++)
-        vertIds->SetId(i,i+j);
+        vertIds->SetId(i,vertLocator->insertUniqueVertice(corners[i]));
 
     initAll();
 }
 
 void HexBlock::init(vtkSmartPointer<vtkIdList> myVertIds,
                     vtkSmartPointer<vtkPoints> verts,
-                    vtkSmartPointer<vtkCollection> edges,
-                    vtkSmartPointer<vtkCollection> patches)
+                    vtkSmartPointer<HexEdgeCollection> edges,
+                    vtkSmartPointer<HexPatchCollection> patches)
 {
     globalVertices = verts;
     globalEdges = edges;
@@ -126,12 +108,12 @@ void HexBlock::init(vtkSmartPointer<vtkIdList> myVertIds,
 //Extrude from patch and distance
 void HexBlock::init(vtkSmartPointer<HexPatch> p,
                     double dist,
-                    vtkSmartPointer<vtkPoints> verts,
-                    vtkSmartPointer<vtkCollection> edges,
-                    vtkSmartPointer<vtkCollection> patches)
+                    HexVertexLocator *vertLocator,
+                    vtkSmartPointer<HexEdgeCollection> edges,
+                    vtkSmartPointer<HexPatchCollection> patches)
 {
     HexBlock * fromHex = p->getPrimaryHexBlock();
-    globalVertices=verts;
+    globalVertices=vertLocator->getPoints();
     globalEdges = edges;
     globalPatches = patches;
 
@@ -154,7 +136,7 @@ void HexBlock::init(vtkSmartPointer<HexPatch> p,
 // I would make sense to create 4 new vertices for the extruded block, only if
 // the extrusion of a list of patches were permited. However, it is not the
 // case, and thus it is more useful to check if new vertices are needed.
-        ptId = insertUniqueVertice(globalVertices, newCoords);
+        ptId = vertLocator->insertUniqueVertice(newCoords);
         newIds->SetId(i, ptId);
     }
 
@@ -295,116 +277,17 @@ bool HexBlock::getGradings(double gradings[12])
             );
 }
 
-void HexBlock::drawLocalaxes()
-{
-    unsigned char red[3] = {255, 0, 0};
-    unsigned char green[3] = {0, 255, 0};
-    unsigned char blue[3] = {0, 0, 255};
-    vtkSmartPointer<vtkUnsignedCharArray> colors =
-            vtkSmartPointer<vtkUnsignedCharArray>::New();
-    colors->SetNumberOfComponents(3);
-    colors->SetName("Colors");
-    colors->InsertNextTupleValue(red);
-    colors->InsertNextTupleValue(green);
-    colors->InsertNextTupleValue(blue);
-
-    vtkSmartPointer<vtkCellArray> axes =
-            vtkSmartPointer<vtkCellArray>::New();
-//    axes->SetNumberOfCells(3); //don't do this, this doubles the number of lines why?
-//    axes->InitTraversal();
-
-
-    vtkSmartPointer<vtkLine> xaxes =
-            vtkSmartPointer<vtkLine>::New();
-    xaxes->GetPointIds()->SetId(0,vertIds->GetId(0));
-    xaxes->GetPointIds()->SetId(1,vertIds->GetId(1));
-    axes->InsertNextCell(xaxes);
-
-    vtkSmartPointer<vtkLine> yaxes =
-            vtkSmartPointer<vtkLine>::New();
-    yaxes->GetPointIds()->SetId(0,vertIds->GetId(0));
-    yaxes->GetPointIds()->SetId(1,vertIds->GetId(3));
-    axes->InsertNextCell(yaxes);
-
-    vtkSmartPointer<vtkLine> zaxes =
-            vtkSmartPointer<vtkLine>::New();
-    zaxes->GetPointIds()->SetId(0,vertIds->GetId(0));
-    zaxes->GetPointIds()->SetId(1,vertIds->GetId(4));
-    axes->InsertNextCell(zaxes);
-
-    axesData = vtkSmartPointer<vtkPolyData>::New();
-    axesData->SetPoints(globalVertices);
-    axesData->SetLines(axes);
-
-    axesData->GetCellData()->SetScalars(colors);
-
-#if VTK_MAJOR_VERSION >= 6
-    axesTubes->SetInputData(axesData);
-#else
-    axesTubes->SetInput(axesData);
-#endif    
-    axesTubes->SetNumberOfSides(24);
-    axesTubes->SetCapping(1);
-
-    // Visualize
-    vtkSmartPointer<vtkPolyDataMapper> axesMapper =
-      vtkSmartPointer<vtkPolyDataMapper>::New();
-    axesMapper->SetInputConnection(axesTubes->GetOutputPort());
-
-
-    hexAxisActor->SetMapper(axesMapper);
-    double x[3];
-    globalVertices->GetPoint(vertIds->GetId(0),x);
-    hexAxisActor->SetOrigin(x);
-    hexAxisActor->SetScale(0.4);
-    //hexActor->GetProperty()->SetLineWidth(3);
-    hexAxisActor->SetPickable(false);
-}
-
 void HexBlock::drawBlock()
 {
-    vtkSmartPointer<vtkHexahedron> hexahedron =
-            vtkSmartPointer<vtkHexahedron>::New();
-    for(vtkIdType i=0;i<8;i++)
-    {
-        hexahedron->GetPointIds()->SetId(i,vertIds->GetId(i));
-    }
-
-    vtkSmartPointer<vtkCellArray> hexes =
-            vtkSmartPointer<vtkCellArray>::New();
-    hexes->InsertNextCell(hexahedron);
-
-    vtkSmartPointer<vtkUnstructuredGrid> uGrid =
-             vtkSmartPointer<vtkUnstructuredGrid>::New();
-    uGrid->SetPoints(globalVertices);
-    uGrid->InsertNextCell(hexahedron->GetCellType(), hexahedron->GetPointIds());
-
-    vtkSmartPointer<vtkDataSetMapper> hexaMapper =
-             vtkSmartPointer<vtkDataSetMapper>::New();
-#if VTK_MAJOR_VERSION <= 5
-    hexaMapper->SetInputConnection(uGrid->GetProducerPort());
-#else
-    hexaMapper->SetInputData(uGrid);
-#endif
-
-    hexBlockActor->SetMapper(hexaMapper);
-    double c[3];
-    getCenter(c);
-    hexBlockActor->SetOrigin(c);
-    hexBlockActor->SetScale(0.4);
-    hexBlockActor->GetProperty()->SetColor(0,100,110);
-    hexBlockActor->GetProperty()->SetEdgeColor(0,0,0);
-    hexBlockActor->GetProperty()->EdgeVisibilityOn();
-    hexBlockActor->SetVisibility(true);
-    hexBlockActor->GetProperty()->SetOpacity(6.0);
-
+    //the cell in the shared grid is replaced by HexBlockRepresentation,
+    //the local axes by HexAxesRepresentation
+    this->Modified();
 }
 
 void HexBlock::initAll()
 {
     initEdges();
     initPatches();
-    drawLocalaxes();
     drawBlock();
 }
 
@@ -432,39 +315,19 @@ void HexBlock::initEdges()
 
 void HexBlock::initEdge(vtkIdType p0, vtkIdType p1)
 {
-    vtkSmartPointer<HexEdge> newEdge =
-            vtkSmartPointer<HexEdge>::New();
-    newEdge->init(p0,p1,globalVertices);
-    bool existsInGlobal = false;
-    vtkIdType posInGlobal=-1;
-
-    for(vtkIdType i=0;i<globalEdges->GetNumberOfItems();i++)
+    //look it up in the global index before creating a new one
+    HexEdge *e = globalEdges->findEdge(p0,p1);
+    if(e != NULL)
     {
-        HexEdge *e = HexEdge::SafeDownCast(globalEdges->GetItemAsObject(i));
-        if(newEdge->equals(e))
-        {
-//            std::cout<< " edge already exists!" << std::endl;
-            existsInGlobal = true;
-            posInGlobal=i;
-            break;
-        }
-    }
-
-    if(!existsInGlobal)
-    {
-//        std::cout << "adding edge ("
-//                  << newEdge->vertIds->GetId(0) << ","
-//                  << newEdge->vertIds->GetId(1) << ")"
-//                  << std::endl;
-        globalEdges->AddItem(newEdge);
-        localEdges->AddItem(newEdge);
-    }
-    else
-    {
-        HexEdge *e = HexEdge::SafeDownCast(globalEdges->GetItemAsObject(posInGlobal));
         localEdges->AddItem(e);
+        return;
     }
 
+    vtkSmartPointer<HexEdge> newEdge =
+            vtkSmartPointer<HexEdge>::New();
+    newEdge->init(p0,p1,globalVertices);
+    globalEdges->AddItem(newEdge);
+    localEdges->AddItem(newEdge);
 }
 
 void HexBlock::initPatches()
@@ -492,6 +355,18 @@ void HexBlock::initPatches()
 
 void HexBlock::initPatch(int id0,int id1,int id2,int id3)
 {
+    HexPatch * existingPatch = globalPatches->findPatch(
+                vertIds->GetId(id0),vertIds->GetId(id1),
+                vertIds->GetId(id2),vertIds->GetId(id3));
+    if(existingPatch != NULL)
+    {
+        //patch already exist, only add reference to this
+        //in the existing one, needed by extrude.
+        existingPatch->setHex(this);
+        localPatches->AddItem(existingPatch);
+        return;
+    }
+
     vtkSmartPointer<HexPatch> patch = vtkSmartPointer<HexPatch>::New();
 
     vtkSmartPointer<vtkIdList> vlist = //patch list of vertIds
@@ -504,23 +379,9 @@ void HexBlock::initPatch(int id0,int id1,int id2,int id3)
 
     patch->init(vlist,globalVertices,this);
 
-    vtkIdType pId=patchIdInGlobalList(patch);
-    if(pId >= 0)
-    {
-        //patch already exist, only add reference to this
-        //in the existing one, needed by extrude.
-        //std::cout << "item is present" << std::endl;
-        HexPatch * existingPatch =
-                HexPatch::SafeDownCast(globalPatches->GetItemAsObject(pId));
-        existingPatch->setHex(this);
-        localPatches->AddItem(existingPatch);
-    }
-    else //i.e. it doesn't exist in global list
-    {
-        //add to global and local collection
-        globalPatches->AddItem(patch);
-        localPatches->AddItem(patch);
-    }
+    //add to global and local collection
+    globalPatches->AddItem(patch);
+    localPatches->AddItem(patch);
 }
 
 
@@ -576,46 +437,38 @@ void HexBlock::getNumberOfCells(int nCells[3])
     nCells[2] = HexEdge::SafeDownCast(localEdges->GetItemAsObject(8))->nCells;
 }
 
-void HexBlock::setAxesRadius(double rad)
-{
-    axesTubes->SetRadius(rad);
-}
-
 
 
 vtkIdType HexBlock::patchIdInGlobalList(vtkSmartPointer<HexPatch> p)
 {
-    for(vtkIdType i=0;i<globalPatches->GetNumberOfItems();i++)
-    {
-//        std::cout << "checking with patch: " << i << std::endl;
-        HexPatch * op =
-                HexPatch::SafeDownCast(globalPatches->GetItemAsObject(i) );
-        if(op->equals(p))
-        {
-//            std::cout << "Patch" << i <<" already exist" << std::endl;
-            return i;
-        }
-    }
-
-    return -1;
+    return globalPatches->findPatchId(p->vertIds);
 }
 
 void HexBlock::rescaleActor()
 {
-    double x[3];
-    globalVertices->GetPoint(vertIds->GetId(0),x);
-    hexAxisActor->SetOrigin(x);
-    hexAxisActor->SetScale(0.4);
-
-    double c[3];
-    getCenter(c);
-    hexBlockActor->SetOrigin(c);
-    hexBlockActor->SetScale(0.4);
+    drawBlock();
+}
+
+void HexBlock::setColor(double r, double g, double b)
+{
+    color[0]=r;
+    color[1]=g;
+    color[2]=b;
+    //the representation redraws modified blocks
+    this->Modified();
 }
 
 void HexBlock::resetColor()
 {
-    hexBlockActor->GetProperty()->SetColor(0,100,110);
+    setColor(0.0,1.0,1.0);
+}
+
+void HexBlock::setVisibility(bool mode)
+{
+    if(visible == mode)
+        return;
+    visible = mode;
+    this->Modified();
 }
 
 void HexBlock::getCenter(double center[])
@@ -642,20 +495,23 @@ void HexBlock::changeVertId(vtkIdType from, vtkIdType to)
     {
         vertIds->SetId(pos,to);
     }
-    drawLocalaxes();
     drawBlock();
 }
 
-void HexBlock::reduceVertId(vtkIdType vId)
+void HexBlock::remapVertIds(const std::vector<vtkIdType> &newIds)
 {
+    bool changed = false;
     for(vtkIdType i=0;i<vertIds->GetNumberOfIds();i++)
     {
         vtkIdType oldId = vertIds->GetId(i);
-        if(oldId > vId)
-            vertIds->SetId(i,oldId-1);
+        if(oldId < vtkIdType(newIds.size()) && newIds[oldId] != oldId)
+        {
+            vertIds->SetId(i,newIds[oldId]);
+            changed = true;
+        }
     }
-    drawLocalaxes();
-    drawBlock();
+    if(changed)
+        drawBlock();
 }
 
 void HexBlock::replacePatch(vtkSmartPointer<HexPatch> oldPatch,
@@ -679,22 +535,6 @@ vtkIdList * HexBlock::commonVertices(HexBlock *hb)
     return comVerts;
 }
 
-vtkIdType HexBlock::insertUniqueVertice(vtkSmartPointer<vtkPoints> verts, double pos[3])
-{
-    double tmpCoords[3];
-    vtkIdType ptId;
-    vtkIdType nGv=verts->GetNumberOfPoints();
-    for(ptId=0; ptId<nGv; ptId++)
-    {
-        verts->GetPoint(ptId, tmpCoords);
-        if(tmpCoords[0]==pos[0] && tmpCoords[1]==pos[1] && tmpCoords[2]==pos[2])
-            break;
-    }
-    if(ptId==nGv)
-        verts->InsertNextPoint(pos);
-    return ptId;
-}
-
 bool HexBlock::hasVertice(vtkIdType vId)
 {
     return vertIds->IsId(vId) > -1;
@@ -37,23 +37,21 @@ Description
 #include <vtkObject.h>
 #include <iostream>
 #include <QTextStream>
+#include <vector>
 
 //Pre declarations
 class HexPatch;
 class HexEdge;
+class HexEdgeCollection;
+class HexPatchCollection;
+class HexVertexLocator;
 class vtkIdList;
 class vtkPoints;
 class vtkPolyData;
 class vtkQuads;
-class vtkCollection;
+class HexCollection;
 class vtkLine;
-class vtkMapper;
-class vtkActor;
-class vtkTubeFilter;
 class vtkCellArray;
-class vtkHexahedron;
-class vtkUnstructuredGrid;
-class vtkDataSetMapper;
 
 
 
@@ -74,24 +72,26 @@ public:
     static HexBlock *New();
     void PrintSelf(ostream &os, vtkIndent indent);
 
-    // Construct from two corner vertices
+    // Construct from two corner vertices, corners within the merge
+    // tolerance of existing vertices use those.
     void init(double corner0[3], double corner1[3],
-              vtkSmartPointer<vtkPoints> verts,
-              vtkSmartPointer<vtkCollection> edges,
-              vtkSmartPointer<vtkCollection> patches);
+              HexVertexLocator *vertLocator,
+              vtkSmartPointer<HexEdgeCollection> edges,
+              vtkSmartPointer<HexPatchCollection> patches);
 
-    // Extrude from a patch, distance and global list of vertices, edges and patches
+    // Extrude from a patch, distance and global list of vertices, edges and patches.
+    // New vertices are only created if the locator doesn't find existing ones.
     void init(vtkSmartPointer<HexPatch> p, double dist,
-              vtkSmartPointer<vtkPoints> verts,
-              vtkSmartPointer<vtkCollection> edges,
-              vtkSmartPointer<vtkCollection> patches);
+              HexVertexLocator *vertLocator,
+              vtkSmartPointer<HexEdgeCollection> edges,
+              vtkSmartPointer<HexPatchCollection> patches);
 
     //Construct from a list of vertices that exists in globalVertices,
     // edges and patches are added if not already existing
     void init(vtkSmartPointer<vtkIdList> myVertIds,
               vtkSmartPointer<vtkPoints> verts,
-              vtkSmartPointer<vtkCollection> edges,
-              vtkSmartPointer<vtkCollection> patches);
+              vtkSmartPointer<HexEdgeCollection> edges,
+              vtkSmartPointer<HexPatchCollection> patches);
 
     //if otherP is found vtkIdType 1-5 is returned, else -1.
     vtkIdType getPatchInternalId(vtkSmartPointer<HexPatch> otherP);
@@ -102,15 +102,18 @@ public:
     //returns the total number of cells in the block
     void getNumberOfCells(int nCells[3]);
 
-    //set the representaton radius of the red,blue and green axes.
-    void setAxesRadius(double rad);
-
-    //resets the center and rescales the axis
+    //the block and its local axes are redrawn at next render,
+    //call when its vertices have moved
     void rescaleActor();
 
+    //colour of the box, see HexBlockRepresentation
+    void setColor(double r, double g, double b);
     //reset the color of the box
     void resetColor();
 
+    //hide or show the box of this block
+    void setVisibility(bool mode);
+
     //returns the center of the block, calculated as the
     //average of all vertices.
     void getCenter(double center[3]);
@@ -119,8 +122,9 @@ public:
     //are ids in the global lsit
     void changeVertId(vtkIdType from, vtkIdType to);
 
-    //reduces the ids if they are greater than vId
-    void reduceVertId(vtkIdType vId);
+    //renumbers the vertices, the new id of vertice i is newIds[i].
+    //the block is only redrawn if an id changed.
+    void remapVertIds(const std::vector<vtkIdType> &newIds);
 
     //replaces a patch, used by merge
     void replacePatch(vtkSmartPointer<HexPatch> oldPatch,
@@ -138,9 +142,6 @@ public:
     // returns a list of common vertices. NOT YET TESTED
     vtkIdList* commonVertices(HexBlock *hb);
 
-    // returns the ID of a vertice, inserting it if needed
-    vtkIdType insertUniqueVertice(vtkSmartPointer<vtkPoints> verts, double pos[3]);
-
     // returns true if vId is in vertIds
     bool hasVertice(vtkIdType vId);
 
@@ -156,40 +157,27 @@ public:
 
     //DATA
     vtkSmartPointer<vtkPoints> globalVertices; //Global list of vertices
-    vtkSmartPointer<vtkCollection> globalEdges;
-    vtkSmartPointer<vtkCollection> globalPatches;
+    vtkSmartPointer<HexEdgeCollection> globalEdges;
+    vtkSmartPointer<HexPatchCollection> globalPatches;
     vtkSmartPointer<vtkPolyData> hexData;
     vtkSmartPointer<vtkIdList> vertIds; // own vertices in globalVertices
-    vtkSmartPointer<vtkCollection> localPatches; //own patches
-    vtkSmartPointer<vtkCollection> localEdges; //own edges
-    vtkSmartPointer<vtkActor> hexAxisActor; //for axes.
-    vtkSmartPointer<vtkActor> hexBlockActor; //for axes.
+    vtkSmartPointer<HexCollection> localPatches; //own patches
+    vtkSmartPointer<HexCollection> localEdges; //own edges
+    double color[3];
+    bool visible;
 
 private:
     //FUNCTIONS
     //creates edges and patches
     void initAll();
 
-    //the litle red,green and blue representations
-    //of the local coordinates
-    void drawLocalaxes();
-
-    // draws a blue block.
+    // the block is redrawn with new vertices at next render
     void drawBlock();
 
     void initEdge(vtkIdType p0,vtkIdType p1);
     void initPatches();
     void initPatch(int id0,int id1,int id2,int id3);
     vtkIdType patchIdInGlobalList(vtkSmartPointer<HexPatch> p);
-
-    //DATA
-    vtkSmartPointer<vtkPolyData> axesData;
-    vtkSmartPointer<vtkTubeFilter> axesTubes;
-
-//    vtkSmartPointer<vtkHexahedron> hexahedron;
-//    vtkSmartPointer<vtkCellArray> hexes;
-//    vtkSmartPointer<vtkUnstructuredGrid> uGrid;
-//    vtkSmartPointer<vtkDataSetMapper> hexaMapper;
 };
 
 #endif // HEXBLOCK_H
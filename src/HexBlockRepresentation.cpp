@@ -0,0 +1,236 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexBlockRepresentation.h"
+#include "HexBlock.h"
+#include "HexCollection.h"
+#include "HexDirtyItems.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkIntArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkCellData.h>
+#include <vtkPolyData.h>
+#include <vtkHexahedron.h>
+#include <vtkMeshQuality.h>
+#include <vtkLookupTable.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkActor.h>
+#include <vtkCellLocator.h>
+#include <vtkProperty.h>
+
+vtkStandardNewMacro(HexBlockRepresentation);
+
+//the faces of a hexahedron as in vtkHexahedron
+static const vtkIdType hexFaces[6][4] = {
+    {0,4,7,3}, {1,2,6,5}, {0,1,5,4},
+    {3,7,6,2}, {0,3,2,1}, {4,5,6,7}};
+static const double shrinkFactor = 0.4;
+
+HexBlockRepresentation::HexBlockRepresentation()
+{
+    dirty = vtkSmartPointer<HexDirtyItems>::New();
+    points = vtkSmartPointer<vtkPoints>::New();
+    quads = vtkSmartPointer<vtkCellArray>::New();
+    blockIds = vtkSmartPointer<vtkIntArray>::New();
+    blockIds->SetName("blockIds");
+    quality = vtkSmartPointer<vtkDoubleArray>::New();
+    quality->SetName("quality");
+    hex = vtkSmartPointer<vtkHexahedron>::New();
+
+    data = vtkSmartPointer<vtkPolyData>::New();
+    data->SetPoints(points);
+    data->SetPolys(quads);
+    data->GetCellData()->SetScalars(blockIds);
+
+    colors = vtkSmartPointer<vtkLookupTable>::New();
+
+    mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+#if VTK_MAJOR_VERSION >= 6
+    mapper->SetInputData(data);
+#else
+    mapper->SetInput(data);
+#endif
+    mapper->SetLookupTable(colors);
+    mapper->SetScalarModeToUseCellData();
+    mapper->UseLookupTableScalarRangeOn();
+
+    actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetMapper(mapper);
+
+    locator = vtkSmartPointer<vtkCellLocator>::New();
+    actor->GetProperty()->SetEdgeColor(0,0,0);
+    actor->GetProperty()->EdgeVisibilityOn();
+}
+
+HexBlockRepresentation::~HexBlockRepresentation()
+{
+
+}
+
+void HexBlockRepresentation::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "blocks: " << shown.size() << std::endl;
+}
+
+void HexBlockRepresentation::setBlocks(HexCollection *blockList, vtkPoints *verts)
+{
+    blocks = blockList;
+    vertices = verts;
+    this->Modified();
+}
+
+void HexBlockRepresentation::update()
+{
+    if(blocks == NULL)
+        return;
+
+    if(blocks->GetMTime() > buildTime || this->GetMTime() > buildTime)
+    {
+        rebuild();
+        return;
+    }
+
+    //only the blocks that are marked as modified, e.g. by
+    //rescaleActor when their vertices have moved
+    std::vector<vtkIdType> ids;
+    dirty->takeDirty(ids);
+    if(ids.empty())
+        return;
+
+    bool shownChanged = false;
+    for(size_t i=0;i<ids.size();i++)
+    {
+        updateBlock(ids[i]);
+        HexBlock *hb = HexBlock::SafeDownCast(blocks->GetItemAsObject(ids[i]));
+        shownChanged = shownChanged || hb->visible != shown[ids[i]];
+    }
+    if(shownChanged)
+        rebuildQuads();
+
+    points->Modified();
+    quality->Modified();
+    colors->Modified();
+    data->Modified();
+}
+
+void HexBlockRepresentation::rebuild()
+{
+    dirty->watch(blocks);
+
+    vtkIdType numBlocks = blocks->GetNumberOfItems();
+    points->SetNumberOfPoints(8*numBlocks);
+    quality->SetNumberOfValues(numBlocks);
+    if(numBlocks > 0)
+    {
+        colors->SetNumberOfTableValues(numBlocks);
+        //one table value per block id
+        colors->SetTableRange(-0.5,numBlocks-0.5);
+    }
+    shown.assign(numBlocks,false);
+
+    for(vtkIdType i=0;i<numBlocks;i++)
+        updateBlock(i);
+    rebuildQuads();
+
+    points->Modified();
+    quality->Modified();
+    colors->Modified();
+    buildTime.Modified();
+}
+
+void HexBlockRepresentation::rebuildQuads()
+{
+    quads->Initialize();
+    blockIds->Initialize();
+    for(vtkIdType i=0;i<vtkIdType(shown.size());i++)
+    {
+        HexBlock *hb = HexBlock::SafeDownCast(blocks->GetItemAsObject(i));
+        shown[i] = hb->visible;
+        if(!hb->visible)
+            continue;
+        for(int f=0;f<6;f++)
+        {
+            quads->InsertNextCell(4);
+            for(int k=0;k<4;k++)
+                quads->InsertCellPoint(8*i+hexFaces[f][k]);
+            blockIds->InsertNextValue(i);
+        }
+    }
+    data->Modified();
+}
+
+void HexBlockRepresentation::updateBlock(vtkIdType i)
+{
+    HexBlock *hb = HexBlock::SafeDownCast(blocks->GetItemAsObject(i));
+    double pos[8][3];
+    double c[3]={0.0,0.0,0.0};
+    for(vtkIdType k=0;k<8;k++)
+    {
+        vertices->GetPoint(hb->vertIds->GetId(k),pos[k]);
+        hex->GetPoints()->SetPoint(k,pos[k]);
+        for(int j=0;j<3;j++)
+            c[j] += pos[k][j]/8.0;
+    }
+    for(vtkIdType k=0;k<8;k++)
+    {
+        //corner = c + s*(v - c), as vtkShrinkFilter
+        double p[3];
+        for(int j=0;j<3;j++)
+            p[j] = c[j] + shrinkFactor*(pos[k][j]-c[j]);
+        points->SetPoint(8*i+k,p);
+    }
+    quality->SetValue(i,vtkMeshQuality::HexScaledJacobian(hex));
+    colors->SetTableValue(i,hb->color[0],hb->color[1],hb->color[2]);
+}
+
+vtkIdType HexBlockRepresentation::getBlockId(vtkIdType cellId)
+{
+    if(cellId < 0 || cellId >= blockIds->GetNumberOfTuples())
+        return -1;
+    return blockIds->GetValue(cellId);
+}
+
+double HexBlockRepresentation::getQuality(vtkIdType i)
+{
+    if(i < 0 || i >= quality->GetNumberOfTuples())
+        return 0.0;
+    return quality->GetValue(i);
+}
+
+vtkCellLocator * HexBlockRepresentation::getLocator()
+{
+    vtkDataSet *out = data;
+    if(locator->GetDataSet() != out || out->GetMTime() > locatorTime)
+    {
+        locator->SetDataSet(out);
+        locator->BuildLocator();
+        locatorTime.Modified();
+    }
+    return locator;
+}
@@ -0,0 +1,123 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Draws all blocks in the model with a single polydata, mapper and
+    actor, as HexPatchRepresentation does for the patches. Each visible
+    block is six quads shrunk to 0.4 around its center. The shrunk
+    corners are computed here, eight points per block, for the blocks
+    modified since the last update (see HexDirtyItems), so moving a
+    vertice rewrites only the points of the blocks that use it and no
+    filter runs over the whole model. The quality (scaled jacobian) is
+    computed for the same blocks. The position of the block in the list
+    is stored as cell scalar, for colour and picking. The quads are only
+    recreated when blocks are added, removed, hidden or shown.
+*/
+
+#ifndef HEXBLOCKREPRESENTATION_H
+#define HEXBLOCKREPRESENTATION_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+
+class HexCollection;
+class HexDirtyItems;
+class vtkPoints;
+class vtkCellArray;
+class vtkIntArray;
+class vtkDoubleArray;
+class vtkPolyData;
+class vtkHexahedron;
+class vtkLookupTable;
+class vtkPolyDataMapper;
+class vtkActor;
+class vtkCellLocator;
+
+class HexBlockRepresentation : public vtkObject
+{
+    vtkTypeMacro(HexBlockRepresentation,vtkObject)
+
+protected:
+    HexBlockRepresentation();
+    ~HexBlockRepresentation();
+    HexBlockRepresentation(const HexBlockRepresentation&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexBlockRepresentation&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexBlockRepresentation *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the blocks to draw and the vertices they refer to
+    void setBlocks(HexCollection *blockList, vtkPoints *verts);
+
+    //brings the polydata and colours up to date with the blocks,
+    //only the blocks modified since the last call are redone.
+    void update();
+
+    //the position in the block list of the block drawn by cell cellId
+    //of the rendered data, -1 if there is no such cell.
+    vtkIdType getBlockId(vtkIdType cellId);
+
+    //locator of the rendered data for the picker, rebuilt
+    //if the data has changed since the last pick
+    vtkCellLocator * getLocator();
+
+    //scaled jacobian of block i, from the last update
+    double getQuality(vtkIdType i);
+
+    //DATA
+    vtkSmartPointer<vtkActor> actor;
+
+private:
+    //FUNCTIONS
+    //recomputes every block and the quads
+    void rebuild();
+    //recreates the quads of the visible blocks
+    void rebuildQuads();
+    //shrunk corners, quality and colour of block i
+    void updateBlock(vtkIdType i);
+
+    //DATA
+    vtkSmartPointer<HexCollection> blocks;
+    vtkSmartPointer<vtkPoints> vertices;
+    vtkSmartPointer<HexDirtyItems> dirty;
+    vtkSmartPointer<vtkPoints> points;
+    vtkSmartPointer<vtkCellArray> quads;
+    vtkSmartPointer<vtkIntArray> blockIds;
+    vtkSmartPointer<vtkPolyData> data;
+    vtkSmartPointer<vtkDoubleArray> quality; //by block
+    vtkSmartPointer<vtkHexahedron> hex; //for the quality
+    vtkSmartPointer<vtkLookupTable> colors;
+    vtkSmartPointer<vtkPolyDataMapper> mapper;
+    std::vector<bool> shown; //by block, has quads
+
+    vtkTimeStamp buildTime;
+    vtkSmartPointer<vtkCellLocator> locator;
+    vtkTimeStamp locatorTime;
+};
+
+#endif // HEXBLOCKREPRESENTATION_H
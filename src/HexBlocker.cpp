@@ -25,26 +25,29 @@ License
 
 
 #include <limits>
+#include <cmath>
+#include <algorithm>
+#include <set>
+#include <functional>
 #include "HexBlocker.h"
 #include "HexBlock.h"
 #include "HexPatch.h"
+#include "HexPatchCollection.h"
 #include "HexEdge.h"
+#include "HexEdgeCollection.h"
+#include "HexCollection.h"
+#include "HexVertexLocator.h"
+#include "HexIncidence.h"
+#include "HexEdgeClasses.h"
+#include "HexUndoStack.h"
 #include "HexBC.h"
 #include "HexReader.h"
+#include "HexGeometry.h"
 
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
-#include <vtkSphereSource.h>
-#include <vtkGlyph3D.h>
 
-#include <vtkCollection.h>
 #include <vtkIdList.h> //Ta bort?
-#include <vtkPolyDataMapper.h>
-#include <vtkActor.h>
-#include <vtkRenderer.h>
-#include <vtkRenderWindow.h>
-
-#include <vtkPlaneSource.h>
 
 #include <vtkCellArray.h>
 #include <vtkQuad.h>
@@ -52,18 +55,10 @@ License
 
 #include <vtkMath.h>
 
-#include <vtkLabeledDataMapper.h>
-#include <vtkActor2D.h>
-#include <vtkProperty2D.h>
-
-#include <vtkOrientationMarkerWidget.h>
-#include <vtkAxesActor.h>
-
 //#include <vtkGeneralTransform.h>
 #include <vtkTransform.h>
 #include <vtkAbstractTransform.h>
 //#include <vtkTransformPolyDataFilter.h>
-#include <vtkCamera.h>
 
 HexBlocker::HexBlocker()
 {
@@ -71,90 +66,45 @@ HexBlocker::HexBlocker()
     vertices = vtkSmartPointer<vtkPoints>::New();
     vertData = vtkSmartPointer<vtkPolyData>::New();
     vertData->SetPoints(vertices);
+    vertLocator = vtkSmartPointer<HexVertexLocator>::New();
+    vertLocator->setPoints(vertices);
+
+    //Which blocks, patches and edges use a vertice
+    incidence = vtkSmartPointer<HexIncidence>::New();
 
     //All patches in the model
-    patches = vtkSmartPointer<vtkCollection>::New();
+    patches = vtkSmartPointer<HexPatchCollection>::New();
 
     //All edges in the model
-    edges = vtkSmartPointer<vtkCollection>::New();
+    edges = vtkSmartPointer<HexEdgeCollection>::New();
 
     //All hexblocks in the model
-    hexBlocks = vtkSmartPointer<vtkCollection>::New();
+    hexBlocks = vtkSmartPointer<HexCollection>::New();
 
-    //Boundary conditions in the model
-    hexBCs = vtkSmartPointer<vtkCollection>::New();
-
-    //Representations
-    vertSphere = vtkSmartPointer<vtkSphereSource>::New();
-    vertSphere->SetThetaResolution(10);
-    vertSphere->SetPhiResolution(10);
-
-    vertGlyph  = vtkSmartPointer<vtkGlyph3D>::New();
-#if VTK_MAJOR_VERSION >= 6
-    vertGlyph->SetInputData(vertData);
-#else
-    vertGlyph->SetInput(vertData);
-#endif    
-    vertGlyph->SetSourceConnection(vertSphere->GetOutputPort());
-
-    vertMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    vertMapper->SetInputConnection(vertGlyph->GetOutputPort());
-
-    vertActor = vtkSmartPointer<vtkActor>::New();
-    vertActor->SetMapper(vertMapper);
-
-    vertLabelMapper = vtkSmartPointer<vtkLabeledDataMapper>::New();
-#if VTK_MAJOR_VERSION >= 6
-    vertLabelMapper->SetInputData(vertData);
-#else
-    vertLabelMapper->SetInput(vertData);
-#endif    
-    vertLabelActor = vtkSmartPointer<vtkActor2D>::New();
-    vertLabelActor->SetMapper(vertLabelMapper);
-    vertLabelActor->GetProperty()->SetColor(1,0,0);
-
-    renderer = vtkSmartPointer<vtkRenderer>::New();
-    renderer->AddActor(vertActor);
-    renderer->AddActor(vertLabelActor);
-    vtkCamera * cam = renderer->GetActiveCamera();
-    cam->SetParallelProjection(1);
-    cam->SetFreezeFocalPoint(1);
-    isRendering=false;
-
-//    widget->SetInteractor( renderer->GetRenderWindow()->GetInteractor() );
-
-//    widget->SetEnabled( 1 );
-
-    GeoActor = vtkSmartPointer<vtkActor>::New();
-    convertToMeters = 1.0;  // to be reset by user, or when reading a blockMeshDict file
-    geoScale = 1.0;         // scale applied to the geommetry
-    hasGeometry = false;
-
-}
+    //Which edges must have the same number of cells
+    edgeClasses = vtkSmartPointer<HexEdgeClasses>::New();
+    edgeClasses->setBlocks(hexBlocks);
 
-HexBlocker::~HexBlocker()
-{
+    //Boundary conditions in the model
+    hexBCs = vtkSmartPointer<HexCollection>::New();
 
-}
+    //Changes that can be undone
+    undoStack = vtkSmartPointer<HexUndoStack>::New();
+    undoStack->setHexBlocker(this);
 
-void HexBlocker::initOrientationAxes(vtkRenderWindow *renwin)
-{
-    // Axes interactor and widget
-    orientationAxes = vtkSmartPointer<vtkAxesActor>::New();
-    orientationAxesWidget = vtkSmartPointer<vtkOrientationMarkerWidget>::New();
-    orientationAxesWidget->SetViewport( 0.0, 0.0, 0.4, 0.4 );
-    orientationAxesWidget->SetOutlineColor( 0.9300, 0.5700, 0.1300 );
-    orientationAxesWidget->SetOrientationMarker( orientationAxes );
-    orientationAxesWidget->SetInteractor(renwin->GetInteractor());
-    orientationAxesWidget->SetEnabled(1);
-    orientationAxesWidget->InteractiveOff();
+    //nothing is drawn until a view sets the callback
+    renderCallback = NULL;
+    renderClientData = NULL;
 
+    geometries = vtkSmartPointer<HexCollection>::New();
+    convertToMeters = 1.0;  // to be reset by user, or when reading a blockMeshDict file
+    geoScale = 1.0;         // scale applied to the geommetry
+    featureAngle = 30.0;    // feature edges of the geometries, in degrees
 
 }
 
-void HexBlocker::removeOrientationAxes()
+HexBlocker::~HexBlocker()
 {
-    orientationAxesWidget->Off();
 
 }
 
@@ -172,16 +122,18 @@ void HexBlocker::createHexBlock()
 
 void HexBlocker::createHexBlock(double c0[3], double c1[3])
 {
+    HexUndoStep step(undoStack,"create block");
     vtkIdType numEdges = edges->GetNumberOfItems();
     vtkIdType numPatches= patches->GetNumberOfItems();
     vtkSmartPointer<HexBlock> hex=
             vtkSmartPointer<HexBlock>::New();
-    hex->init(c0,c1,vertices,edges, patches);
+    hex->init(c0,c1,vertLocator,edges, patches);
     addHexBlockFeatures(hex, numEdges, numPatches);
 }
 
 void HexBlocker::createHexBlock(vtkIdList *selectedVertices)
 {
+    HexUndoStep step(undoStack,"create block");
     vtkIdType numEdges = edges->GetNumberOfItems();
     vtkIdType numPatches = patches->GetNumberOfItems();
     vtkSmartPointer<HexBlock> hex = vtkSmartPointer<HexBlock>::New();
@@ -191,6 +143,7 @@ void HexBlocker::createHexBlock(vtkIdList *selectedVertices)
 
 void HexBlocker::extrudePatch(vtkIdList *selectedPatches, double dist)
 {
+    HexUndoStep step(undoStack,"extrude");
     if(selectedPatches->GetNumberOfIds()<1)
     {
         std::cout << "no patches selected!" << std::endl;
@@ -217,70 +170,64 @@ void HexBlocker::extrudePatch(vtkIdList *selectedPatches, double dist)
 
     vtkSmartPointer<HexBlock> newHex=
             vtkSmartPointer<HexBlock>::New();
-    newHex->init(p,dist,vertices,edges,patches);
+    newHex->init(p,dist,vertLocator,edges,patches);
     addHexBlockFeatures(newHex, numEdges, numPatches);
 }
 
 void HexBlocker::addHexBlockFeatures(vtkSmartPointer<HexBlock> hex, vtkIdType numEdges, vtkIdType numPatches)
+{
+    attachHexBlock(hex,numEdges,numPatches);
+    vertices->Modified();
+    resetBounds();
+    this->render();
+}
+
+HexBlock * HexBlocker::insertHexBlock(vtkIdList *verts)
+{
+    vtkIdType numEdges = edges->GetNumberOfItems();
+    vtkIdType numPatches = patches->GetNumberOfItems();
+    vtkSmartPointer<HexBlock> hex = vtkSmartPointer<HexBlock>::New();
+    hex->init(verts, vertices, edges, patches);
+    attachHexBlock(hex, numEdges, numPatches);
+    return hex;
+}
+
+void HexBlocker::attachHexBlock(HexBlock *hex, vtkIdType numEdges, vtkIdType numPatches)
 {
     hexBlocks->AddItem(hex);
 
-    //add edge actors to renderer, but not already added ones.
+    //the new edges are drawn by the view at next render
     for (vtkIdType i =numEdges;i<edges->GetNumberOfItems();i++)
     {
         HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
-        renderer->AddActor(e->actor);
+        incidence->addEdge(e);
     }
 
-    //add patch actors to renderer, but not already added ones.
+    //the new patches are drawn by the view at next render
     for(vtkIdType i=numPatches;i<patches->GetNumberOfItems();i++)
     {
         HexPatch *p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
-        renderer->AddActor(p->actor);
+        incidence->addPatch(p);
     }
-
-    renderer->AddActor(hex->hexAxisActor);
-    renderer->AddActor(hex->hexBlockActor);
-    vertices->Modified();
-    resetBounds();
-    this->render();
+    incidence->addBlock(hex);
+    edgeClasses->addBlock(hex);
+    undoStack->blockAdded(hex);
 }
 
 void HexBlocker::resetBounds()
 {
-    double minLength=1e6;
-    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
-    {
-        HexEdge * e =
-                HexEdge::SafeDownCast(edges->GetItemAsObject(i));
-        double edgeLength=e->getLength();
-        minLength=fmin(minLength,edgeLength);
-    }
-
-    double vertRadius=minLength*0.02;
-    double edgeRadius=vertRadius*0.5;
-    double locAxesRadius=edgeRadius*3;
-
-    vertSphere->SetRadius(vertRadius);
-    //set radius on edges
     for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
     {
         HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
-        e->setRadius(edgeRadius);
         e->resetColor();
     }
+    //radii and camera are set by the view
+    boundsTime.Modified();
+}
 
-    //set radius on local axes
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
-    {
-        HexBlock * hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-        hb->setAxesRadius(locAxesRadius);
-    }
-
-    double bounds[6];
-    renderer->ComputeVisiblePropBounds(bounds);
-    renderer->ResetCamera(bounds);
-    renderer->Modified();
+unsigned long HexBlocker::getBoundsMTime()
+{
+    return boundsTime.GetMTime();
 }
 void HexBlocker::resetColors()
 {
@@ -365,6 +312,8 @@ void HexBlocker::PrintHexBlocks()
 
 void HexBlocker::exportVertices(QTextStream &os)
 {
+    //the exported ids must be 0..N-1
+    compactVertices();
     os << endl << "vertices" <<endl << "(" <<endl;
     for(vtkIdType i=0;i<vertices->GetNumberOfPoints();i++)
     {
@@ -436,6 +385,7 @@ void HexBlocker::exportEdges(QTextStream &os)
 }
 void HexBlocker:: moveVertices(vtkSmartPointer<vtkIdList> ids,double dist[3])
 {
+    HexUndoStep step(undoStack,"move vertices");
     double pos[3];
     for(vtkIdType i = 0;i<ids->GetNumberOfIds();i++)
     {
@@ -446,15 +396,16 @@ void HexBlocker:: moveVertices(vtkSmartPointer<vtkIdList> ids,double dist[3])
         pos[1]+=dist[1];
         pos[2]+=dist[2];
         //        std::cout << pos[0] << " " << pos[1] << " " << pos[2] << ")." << std::endl;
-        vertices->SetPoint(ids->GetId(i),pos);
+        setVertice(ids->GetId(i),pos);
 
         vertices->Modified();
     }
-    rescaleActors();
+    redrawMovedVertices();
 }
 
 void HexBlocker::setVerticesPos(vtkSmartPointer<vtkIdList> ids, double newPos[3], bool setPos[3])
 {
+    HexUndoStep step(undoStack,"set vertices");
     double pos[3];
     for(vtkIdType i = 0;i<ids->GetNumberOfIds();i++)
     {
@@ -468,15 +419,15 @@ void HexBlocker::setVerticesPos(vtkSmartPointer<vtkIdList> ids, double newPos[3]
         if(setPos[2])
             pos[2]=newPos[2];
         //        std::cout << pos[0] << " " << pos[1] << " " << pos[2] << ")." << std::endl;
-        vertices->SetPoint(ids->GetId(i),pos);
-
+        setVertice(ids->GetId(i),pos);
     }
     vertices->Modified();
-    rescaleActors();
+    redrawMovedVertices();
 }
 
 void HexBlocker:: rotateVertices(vtkSmartPointer<vtkIdList> ids, double angle, double center[3], double axis[3])
 {
+    HexUndoStep step(undoStack,"rotate vertices");
     vtkSmartPointer<vtkTransform> rotation = vtkSmartPointer<vtkTransform>::New();
     rotation->Translate(      center[0], center[1], center[2]); // /\ replace points to its original reference
     rotation->RotateWXYZ(angle, axis[0],   axis[1],   axis[2]); // /\ rotate around origin
@@ -491,12 +442,48 @@ void HexBlocker:: rotateVertices(vtkSmartPointer<vtkIdList> ids, double angle, d
         pos[0] = posout[0];
         pos[1] = posout[1];
         pos[2] = posout[2];
-        vertices->SetPoint(ids->GetId(i),pos);
+        setVertice(ids->GetId(i),pos);
     }
     vertices->Modified();
-    rescaleActors();
+    redrawMovedVertices();
+}
+
+
+void HexBlocker::setVertice(vtkIdType id, double pos[3])
+{
+    double oldPos[3];
+    vertices->GetPoint(id,oldPos);
+    vertices->SetPoint(id,pos);
+    vertLocator->updateVertice(id);
+    undoStack->verticeMoved(id,oldPos,pos);
+    movedVertices.push_back(id);
 }
 
+void HexBlocker::redrawMovedVertices()
+{
+    //only what uses a moved vertice has to be redrawn
+    std::set<HexEdge *> dirtyEdges;
+    std::set<HexPatch *> dirtyPatches;
+    std::set<HexBlock *> dirtyBlocks;
+    for(size_t i=0;i<movedVertices.size();i++)
+    {
+        const HexIncidence::EdgeList &vEdges = incidence->verticeEdges(movedVertices[i]);
+        dirtyEdges.insert(vEdges.begin(),vEdges.end());
+        const HexIncidence::PatchList &vPatches = incidence->verticePatches(movedVertices[i]);
+        dirtyPatches.insert(vPatches.begin(),vPatches.end());
+        const HexIncidence::BlockList &vBlocks = incidence->verticeBlocks(movedVertices[i]);
+        dirtyBlocks.insert(vBlocks.begin(),vBlocks.end());
+    }
+    movedVertices.clear();
+
+    for(std::set<HexEdge *>::iterator it=dirtyEdges.begin();it!=dirtyEdges.end();++it)
+        (*it)->redrawedge();
+    for(std::set<HexPatch *>::iterator it=dirtyPatches.begin();it!=dirtyPatches.end();++it)
+        (*it)->rescaleActor();
+    for(std::set<HexBlock *>::iterator it=dirtyBlocks.begin();it!=dirtyBlocks.end();++it)
+        (*it)->rescaleActor();
+    this->render();
+}
 
 HexEdge *HexBlocker::showParallelEdges(vtkIdType edgeId)
 {
@@ -519,7 +506,7 @@ HexEdge *HexBlocker::showParallelEdges(vtkIdType edgeId)
         }
         else
         {
-            e->setColor(0.0,8.0,0.0);
+            e->setColor(0.0,0.0,1.0);
         }
     }
 
@@ -529,43 +516,25 @@ HexEdge *HexBlocker::showParallelEdges(vtkIdType edgeId)
 void HexBlocker::addParallelEdges(vtkSmartPointer<vtkIdList> allParallelEdges,
                                   vtkIdType edgeId)
 {
-    //    std::cout << "running on edge " << edgeId << std::endl;
-    vtkIdType numEdges = allParallelEdges->GetNumberOfIds();
-
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
-    {
-        vtkSmartPointer<vtkIdList> parallelOnBlock =
-                vtkSmartPointer<vtkIdList>::New();
-        HexBlock * b = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-        parallelOnBlock = b->getParallelEdges(edgeId);
-
-        HexEdge * e = HexEdge::SafeDownCast(edges->GetItemAsObject(edgeId));
-        //        std::cout << " block num: " << i << ", numPar: "
-        //                  << parallelOnBlock->GetNumberOfIds()
-        //                  <<" to edge " << edgeId
-        //                 << "(" << e->vertIds->GetId(0) << " "
-        //                 << e->vertIds->GetId(1) <<")"
-        //                 << std::endl;
-        //insert the new edges if unique
-        for(vtkIdType j=0;j<parallelOnBlock->GetNumberOfIds();j++)
-        {
-            //            std::cout << "\tinserting edge " << parallelOnBlock->GetId(j)<<std::endl;
-            allParallelEdges->InsertUniqueId(parallelOnBlock->GetId(j));
-        }
-    }
+    //the edges already in the list are kept first and not repeated
+    std::set<vtkIdType> inList;
+    for(vtkIdType i=0;i<allParallelEdges->GetNumberOfIds();i++)
+        inList.insert(allParallelEdges->GetId(i));
 
-    //if we added more edges we have to redo for those edges.
-    vtkIdType newNumEdges = allParallelEdges->GetNumberOfIds();
-    for(vtkIdType i=numEdges;i<newNumEdges;i++)
+    HexEdge * e = HexEdge::SafeDownCast(edges->GetItemAsObject(edgeId));
+    const std::vector<HexEdge *> &parEdges = edgeClasses->parallelEdges(e);
+    for(size_t i=0;i<parEdges.size();i++)
     {
-        //        std::cout << "\trerunning on " << i <<", " << allParallelEdges->GetId(i) <<std::endl;
-        addParallelEdges(allParallelEdges,allParallelEdges->GetId(i));
+        vtkIdType parId = edges->IsItemPresent(parEdges[i])-1;
+        if(parId >= 0 && inList.insert(parId).second)
+            allParallelEdges->InsertNextId(parId);
     }
 }
 
 
 void HexBlocker::setEdgePropsOnParallelEdges(HexEdge * props,vtkIdType edgeId,int mode)
 {
+    HexUndoStep step(undoStack,"set edge properties");
     vtkSmartPointer<vtkIdList> allParallelEdges =
             vtkSmartPointer<vtkIdList>::New();
 
@@ -578,14 +547,112 @@ void HexBlocker::setEdgePropsOnParallelEdges(HexEdge * props,vtkIdType edgeId,in
     {
         HexEdge *e = HexEdge::SafeDownCast(
                     edges->GetItemAsObject(allParallelEdges->GetId(i)));
+        int oldNCells = e->nCells;
+        double oldGrading = e->grading;
         e->nCells=props->nCells;
         //set grading if mode is propagate or selected edge
         if(mode==0 || allParallelEdges->GetId(i)==edgeId)
             e->grading=props->grading;
+        undoStack->edgeChanged(e,oldNCells,oldGrading);
     }
 }
 
 
+void HexBlocker::setBCPatches(HexBC *bc, vtkIdList *patchIds)
+{
+    HexUndoStep step(undoStack,"set BC patches");
+    undoStack->bcChanged(bc);
+    bc->insertPatches(patchIds);
+}
+
+HexBC * HexBlocker::createBC(const std::string &name, const std::string &type)
+{
+    HexUndoStep step(undoStack,"create BC");
+    vtkSmartPointer<HexBC> bc = vtkSmartPointer<HexBC>::New();
+    bc->globalPatches = patches;
+    undoStack->bcEdited(bc);
+    bc->name = name;
+    bc->type = type;
+    hexBCs->AddItem(bc);
+    return bc;
+}
+
+void HexBlocker::setBCName(HexBC *bc, const std::string &name, const std::string &type)
+{
+    if(bc->name == name && bc->type == type)
+        return;
+    HexUndoStep step(undoStack,"rename BC");
+    undoStack->bcEdited(bc);
+    bc->name = name;
+    bc->type = type;
+}
+
+void HexBlocker::removeBC(HexBC *bc)
+{
+    if(hexBCs->IsItemPresent(bc) == 0)
+        return;
+    HexUndoStep step(undoStack,"remove BC");
+    undoStack->bcEdited(bc);
+    undoStack->bcChanged(bc);
+    hexBCs->RemoveItem(bc);
+}
+
+void HexBlocker::setEdgeType(HexEdge *e, int type)
+{
+    HexUndoStep step(undoStack,"set edge type");
+    if(e->getType() != type)
+        undoStack->arcChanged(e);
+    e->setType(type == HexEdge::ARC ? HexEdge::ARC : HexEdge::LINE);
+    this->render();
+}
+
+void HexBlocker::setArcControlPoint(HexEdge *e, const double pos[3])
+{
+    if(e->getType() != HexEdge::ARC)
+        return;
+    HexUndoStep step(undoStack,"set arc");
+    undoStack->arcChanged(e);
+    e->setControlPoint(0,pos);
+    e->redrawedge();
+    this->render();
+}
+
+void HexBlocker::setArcFromCenter(HexEdge *e, const double center[3], double radius)
+{
+    if(e->getType() != HexEdge::ARC)
+        return;
+    HexUndoStep step(undoStack,"set arc");
+    undoStack->arcChanged(e);
+    e->calcArcControlPointFromCenter(center,radius);
+    e->redrawedge();
+    this->render();
+}
+
+bool HexBlocker::undo()
+{
+    unsigned long blocksTime = hexBlocks->GetMTime();
+    if(!undoStack->undo())
+        return false;
+    //only what the change touched is redrawn
+    vertices->Modified();
+    if(hexBlocks->GetMTime() > blocksTime)
+        resetBounds();
+    redrawMovedVertices();
+    return true;
+}
+
+bool HexBlocker::redo()
+{
+    unsigned long blocksTime = hexBlocks->GetMTime();
+    if(!undoStack->redo())
+        return false;
+    vertices->Modified();
+    if(hexBlocks->GetMTime() > blocksTime)
+        resetBounds();
+    redrawMovedVertices();
+    return true;
+}
+
 void HexBlocker::readBlockMeshDict(HexReader *reader)
 {
 
@@ -597,33 +664,16 @@ void HexBlocker::readBlockMeshDict(HexReader *reader)
     hexBCs = reader->readBCs;
 
     vertData->SetPoints(vertices);
+    removedVertices.clear();
+    removedTime.Modified();
     vertices->Modified();
+    vertLocator->setPoints(vertices);
+    incidence->build(hexBlocks,edges,patches);
+    edgeClasses->setBlocks(hexBlocks);
+    undoStack->clear();
 
-    //add edge actors renderer
-    for (vtkIdType i =0;i<edges->GetNumberOfItems();i++)
-    {
-        HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
-        renderer->AddActor(e->actor);
-    }
-
-    //add patch actors to renderer
-    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
-    {
-        HexPatch *p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
-        renderer->AddActor(p->actor);
-    }
-
-    // add local coord axis actor of blocks
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
-    {
-        HexBlock *b = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-        renderer->AddActor(b->hexAxisActor);
-        renderer->AddActor(b->hexBlockActor);
-    }
-
-
+    //the view picks up the new lists at next render
     resetBounds();
-    renderer->Modified();
     this->render();
 }
 
@@ -642,6 +692,9 @@ int HexBlocker::calculateTotalNumberOfCells()
 
 void HexBlocker::rescaleActors()
 {
+    //everything is redrawn anyway
+    movedVertices.clear();
+
     //edges presently dont need to be reset
     for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
     {
@@ -655,7 +708,7 @@ void HexBlocker::rescaleActors()
         p->rescaleActor();
     }
 
-    //blocks (local axes)
+    //blocks
     for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
     {
         HexBlock * b = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
@@ -666,23 +719,12 @@ void HexBlocker::rescaleActors()
 
 vtkIdType HexBlocker::findEdge(const vtkIdType a, const vtkIdType b)
 {
-    vtkIdList * list = vtkIdList::New();
-    list->InsertNextId(a);
-    list->InsertNextId(b);
-    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
-    {
-        HexEdge * e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
-        if(e->equals(list))
-        {
-            return i;
-        }
-    }
-    //    list->Delete();
-    return vtkIdType(-1);
+    return edges->findEdgeId(a,b);
 }
 
 void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
 {
+    HexUndoStep step(undoStack,"merge patches");
     HexPatch * master = HexPatch::SafeDownCast(patches->GetItemAsObject(masterId));
     HexPatch * slave  = HexPatch::SafeDownCast(patches->GetItemAsObject(slaveId));
 
@@ -735,10 +777,10 @@ void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
         HexEdge * e = HexEdge::SafeDownCast(edges->GetItemAsObject(eId));
         HexBlock *slaveBlock = slave->getPrimaryHexBlock();
         bool deleteEdge=true;
-        for(vtkIdType bi=0;bi<hexBlocks->GetNumberOfItems();bi++)
+        const HexIncidence::BlockList &eBlocks = incidence->edgeBlocks(e);
+        for(size_t bi=0;bi<eBlocks.size();bi++)
         {
-              HexBlock *b = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(bi));
-              if(! b->equals(slaveBlock) && b->hasEdge(e))
+              if(! eBlocks[bi]->equals(slaveBlock))
               {
                   deleteEdge=false;
                   break;
@@ -746,15 +788,53 @@ void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
         }
         if(deleteEdge)
         {
-            renderer->RemoveActor(e->actor);
+            incidence->removeEdge(e);
             edges->RemoveItem(eId);
         }
     }
 
+    // Only edges, patches and blocks that use the slave
+    // vertices are affected. Take them out of the incidence
+    // tables while their ids change.
+    std::vector<HexEdge *> affEdges;
+    std::vector<HexPatch *> affPatches;
+    std::vector<HexBlock *> affBlocks;
+    for(vtkIdType k=0;k<4;k++)
+    {
+        vtkIdType sId = slaveIds->GetId(k);
+        const HexIncidence::EdgeList &vEdges = incidence->verticeEdges(sId);
+        for(size_t i=0;i<vEdges.size();i++)
+            if(std::find(affEdges.begin(),affEdges.end(),vEdges[i]) == affEdges.end())
+                affEdges.push_back(vEdges[i]);
+        const HexIncidence::PatchList &vPatches = incidence->verticePatches(sId);
+        for(size_t i=0;i<vPatches.size();i++)
+            if(std::find(affPatches.begin(),affPatches.end(),vPatches[i]) == affPatches.end())
+                affPatches.push_back(vPatches[i]);
+        const HexIncidence::BlockList &vBlocks = incidence->verticeBlocks(sId);
+        for(size_t i=0;i<vBlocks.size();i++)
+            if(std::find(affBlocks.begin(),affBlocks.end(),vBlocks[i]) == affBlocks.end())
+                affBlocks.push_back(vBlocks[i]);
+    }
+    for(size_t i=0;i<affBlocks.size();i++)
+    {
+        undoStack->blockRemoved(affBlocks[i]);
+        incidence->removeBlock(affBlocks[i]);
+    }
+    for(size_t i=0;i<affEdges.size();i++)
+        incidence->removeEdge(affEdges[i]);
+    for(size_t i=0;i<affPatches.size();i++)
+        incidence->removePatch(affPatches[i]);
+
+    //Unregister slave patch from the global list now,
+    //while its ids still match the index.
+    vtkSmartPointer<HexPatch> slaveHold = slave;
+    patches->RemoveItem(slave);
+
     // CHANGING IDS of slave patch
-    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
+    for(size_t i=0;i<affEdges.size();i++)
     {
-        HexEdge * e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
+        HexEdge * e = affEdges[i];
+        edges->removeFromIndex(e);
         for(vtkIdType k=0;k<4;k++)
         {
             e->changeVertId(
@@ -762,11 +842,15 @@ void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
                         slaveIdsInMaster->GetId(k));
             e->redrawedge();
         }
+        edges->addToIndex(e);
+        incidence->addEdge(e);
     }
 
-    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
+    for(size_t i=0;i<affPatches.size();i++)
     {
-        HexPatch * p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
+        HexPatch * p = affPatches[i];
+        if(p != slave)
+            patches->removeFromIndex(p);
         for(vtkIdType k=0;k<4;k++)
         {
             p->changeVertId(
@@ -774,11 +858,17 @@ void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
                         slaveIdsInMaster->GetId(k));
         }
         p->rescaleActor(); //Might have to bee removed
+        if(p != slave)
+        {
+            patches->addToIndex(p);
+            incidence->addPatch(p);
+        }
     }
 
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
+    vtkIdType numEdges = edges->GetNumberOfItems();
+    for(size_t i=0;i<affBlocks.size();i++)
     {
-        HexBlock * hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
+        HexBlock * hb = affBlocks[i];
         for(vtkIdType k=0;k<4;k++)
         {
             hb->changeVertId(
@@ -787,6 +877,16 @@ void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
         }
         hb->initEdges();
     }
+    //in case initEdges had to create new edges
+    for(vtkIdType i=numEdges;i<edges->GetNumberOfItems();i++)
+        incidence->addEdge(HexEdge::SafeDownCast(edges->GetItemAsObject(i)));
+    for(size_t i=0;i<affBlocks.size();i++)
+    {
+        incidence->addBlock(affBlocks[i]);
+        undoStack->blockAdded(affBlocks[i]);
+    }
+    //slave edges are gone, the classes are rebuilt when next needed
+    edgeClasses->invalidate();
 
     //Set hex in master patch
     HexBlock *slaveBlock = slave->getPrimaryHexBlock();
@@ -795,7 +895,6 @@ void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
     // Unregister slave patch
     slaveBlock->replacePatch(slave,master);
     //SLAVE PATCH
-    renderer->RemoveActor(slave->actor);
     for(vtkIdType i=0;i<hexBCs->GetNumberOfItems();i++)
     {
         HexBC *bc = HexBC::SafeDownCast(hexBCs->GetItemAsObject(i));
@@ -803,7 +902,6 @@ void HexBlocker::mergePatch(vtkIdType masterId, vtkIdType slaveId)
         bc->removePatchFromList(slave);
 
     }
-    patches->RemoveItem(slave);
 
     removeVerticesSafely(slaveIds);
 
@@ -836,17 +934,14 @@ void HexBlocker::decreaseList(vtkIdList *list, vtkIdType toRem)
 }
 
 
-bool HexBlocker::removeVerticeSafely(vtkIdType toRem )
+bool HexBlocker::isVerticeUsed(vtkIdType vId)
 {
-    bool isItsafe = true;
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++ )
-    {
-        HexBlock *hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-        vtkIdType hasId = hb->vertIds->IsId(toRem);
-        //toRem is not in list if hasId == -1
-        isItsafe = (isItsafe && hasId==-1);
+    return !incidence->verticeBlocks(vId).empty();
+}
 
-    }
+bool HexBlocker::removeVerticeSafely(vtkIdType toRem )
+{
+    bool isItsafe = !isVerticeUsed(toRem);
     if(isItsafe)
         removeVertice(toRem);
 
@@ -855,79 +950,116 @@ bool HexBlocker::removeVerticeSafely(vtkIdType toRem )
 
 void HexBlocker::removeVerticesSafely(vtkIdList *toRemove)
 {
+    //ids don't change until compactVertices,
+    //so no need to decrease the list
     for(vtkIdType i=0;i< toRemove->GetNumberOfIds();i++)
     {
-        bool removed = removeVerticeSafely(toRemove->GetId(i));
-        if(removed)
-            decreaseList(toRemove,toRemove->GetId(i));
+        if(!isVerticeUsed(toRemove->GetId(i)))
+            removeVertice(toRemove->GetId(i));
     }
 }
 
 void HexBlocker::removeVertices(vtkIdList *toRemove)
 {
-    //list cannot be empty
-    vtkIdType prevId = toRemove->GetId(0);
-    removeVertice(toRemove->GetId(0));
-    for(vtkIdType i=1;i<toRemove->GetNumberOfIds();i++)
-    {
-        decreaseList(toRemove,prevId);
-        prevId = toRemove->GetId(i);
-        removeVertice(prevId);
-    }
-
+    for(vtkIdType i=0;i<toRemove->GetNumberOfIds();i++)
+        removeVertice(toRemove->GetId(i));
 }
 
 void HexBlocker::removeVertice(vtkIdType toRem)
 {
-    //Change Ids for existing Hex*
-    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
+    //only mark it, ids are changed by compactVertices
+    if(toRem >= 0 && toRem < vertices->GetNumberOfPoints())
     {
-        HexEdge * e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
-        e->reduceVertId(toRem);
+        removedVertices.insert(toRem);
+        removedTime.Modified();
     }
+}
 
-    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
-    {
-        HexPatch * p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
-        p->reduceVertId(toRem);
-    }
+bool HexBlocker::isVerticeRemoved(vtkIdType id)
+{
+    //a removed vertice may be used again, e.g. by undo
+    return removedVertices.count(id) > 0 && !isVerticeUsed(id);
+}
 
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
+unsigned long HexBlocker::getRemovedVerticesMTime()
+{
+    return removedTime.GetMTime();
+}
+
+const std::set<vtkIdType> & HexBlocker::getRemovedVertices()
+{
+    return removedVertices;
+}
+
+void HexBlocker::compactVertices()
+{
+    if(removedVertices.empty())
+        return;
+
+    //new id of every vertice, -1 for the removed ones
+    //that are not used again
+    vtkIdType nOld = vertices->GetNumberOfPoints();
+    std::vector<vtkIdType> newIds(nOld,0);
+    bool anyRemoved = false;
+    std::set<vtkIdType>::iterator it;
+    for(it=removedVertices.begin();it!=removedVertices.end();++it)
     {
-        HexBlock * hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-        hb->reduceVertId(toRem);
+        if(*it < nOld && !isVerticeUsed(*it))
+        {
+            newIds[*it] = -1;
+            anyRemoved = true;
+        }
     }
+    removedVertices.clear();
+    removedTime.Modified();
+    if(!anyRemoved)
+        return;
 
-    //DELETING VERTICE
     vtkSmartPointer<vtkPoints> newPs =
             vtkSmartPointer<vtkPoints>::New();
-    newPs->SetNumberOfPoints(vertices->GetNumberOfPoints()-1);
     double pos[3];
-    for(vtkIdType i=0;i<vertices->GetNumberOfPoints();i++)
+    vtkIdType n=0;
+    for(vtkIdType i=0;i<nOld;i++)
     {
+        if(newIds[i] < 0)
+            continue;
         vertices->GetPoint(i,pos);
-        if(i < toRem)
-        {
-            newPs->InsertPoint(i,pos);
-        }
-        if(i > toRem)
-        {
-            newPs->InsertPoint(i-1,pos);
-        }
+        newPs->InsertNextPoint(pos);
+        newIds[i] = n++;
     }
+    undoStack->remapVertices(newIds);
 
+    //DeepCopy so that everyone holding the vertices sees the change
     vertices->Initialize();
-
     vertices->DeepCopy(newPs);
 
-    //    vertices->Modified();
+    //Change Ids for existing Hex*, once
+    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
+    {
+        HexEdge * e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
+        e->remapVertIds(newIds);
+    }
+    edges->rebuildIndex();
+
+    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
+    {
+        HexPatch * p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
+        p->remapVertIds(newIds);
+    }
+    patches->rebuildIndex();
+
     for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
     {
         HexBlock * hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
+        hb->remapVertIds(newIds);
         hb->rescaleActor();
     }
 
+    vertLocator->remapVertices(newIds);
+    incidence->remapVertices(newIds);
+    vertices->Modified();
 }
+
 void HexBlocker::removeHexBlock(vtkIdType toRem)
 {
     vtkSmartPointer<vtkIdList> vertsToRem = vtkSmartPointer<vtkIdList>::New();
@@ -937,225 +1069,142 @@ void HexBlocker::removeHexBlock(vtkIdType toRem)
 void HexBlocker::removeHexBlock(vtkIdType toRem,vtkIdList * vertsToRem)
 {
     HexBlock *b2rem = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(toRem));
+    removeHexBlock(b2rem,vertsToRem);
+}
 
-    //Create a list of vertices that can be removed.
-    //start with all verts of b2rem then remove those that aren't used by other blocks
-    vertsToRem->Initialize();
-    vertsToRem->DeepCopy(b2rem->vertIds);
+void HexBlocker::removeHexBlock(HexBlock *b2rem, vtkIdList *vertsToRem)
+{
+    HexUndoStep step(undoStack,"remove block");
+    vtkSmartPointer<vtkIdList> edgeIds2rem = vtkSmartPointer<vtkIdList>::New();
+    vtkSmartPointer<vtkIdList> patchIds2rem = vtkSmartPointer<vtkIdList>::New();
+    detachHexBlock(b2rem,vertsToRem,edgeIds2rem,patchIds2rem);
+    edges->removeItems(edgeIds2rem);
+    patches->removeItems(patchIds2rem);
+    //delete block, vertices are not deleted here
+    hexBlocks->RemoveItem(b2rem);
+}
 
-    //Create a Collection of edges to remove
-    vtkSmartPointer<vtkCollection> edges2rem =
-             vtkSmartPointer<vtkCollection>::New();
-    for(vtkIdType ei=0;ei<b2rem->localEdges->GetNumberOfItems();ei++)
+void HexBlocker::detachHexBlock(HexBlock *b2rem, vtkIdList *vertsToRem,
+                                vtkIdList *edgeIds2rem, vtkIdList *patchIds2rem)
+{
+    undoStack->blockRemoved(b2rem);
+
+    //Create a list of vertices that can be removed,
+    //those that no other block uses
+    vertsToRem->Initialize();
+    for(vtkIdType v=0;v<b2rem->vertIds->GetNumberOfIds();v++)
     {
-        HexEdge *e = HexEdge::SafeDownCast(b2rem->localEdges->GetItemAsObject(ei));
-        edges2rem->AddItem(e);
+        vtkIdType vId = b2rem->vertIds->GetId(v);
+        if(incidence->verticeBlocks(vId).size() == 1)
+            vertsToRem->InsertUniqueId(vId);
     }
 
-    //loop over all blocks but not the one to be deleted
-    //too make sure we don't delete stuff other blocks need
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
+    //Create a list of edges that no other block uses
+    std::vector<HexEdge *> edges2rem;
+    for(vtkIdType ei=0;ei<b2rem->localEdges->GetNumberOfItems();ei++)
     {
-        if(i==toRem)
-            continue; //dont check the block to be deleted!
-
-        HexBlock *hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-
-        //check vertices
-        for(vtkIdType v=0;v<b2rem->vertIds->GetNumberOfIds();v++)
-        {
-            vtkIdType vId = b2rem->vertIds->GetId(v);
-            if(hb->hasVertice(vId))
-            {
-                vertsToRem->DeleteId(vId);
-            }
-        }
-
-        //check edges
-        for(vtkIdType hi=0;hi<hb->localEdges->GetNumberOfItems();hi++)
-        {
-            HexEdge *e = HexEdge::SafeDownCast(hb->localEdges->GetItemAsObject(hi));
-            if(edges2rem->IsItemPresent(e)>0)
-                edges2rem->RemoveItem(e);
-        }
-
+        HexEdge *e = HexEdge::SafeDownCast(b2rem->localEdges->GetItemAsObject(ei));
+        if(incidence->edgeBlocks(e).size() == 1)
+            edges2rem.push_back(e);
     }
+    incidence->removeBlock(b2rem);
+    edgeClasses->invalidate();
 
-
-    //remove the edges (points are not removed in this function)
-    //since we might wan't to keep them for split and ogrids
-    for(vtkIdType i=0;i<edges2rem->GetNumberOfItems();i++)
+    //the edges are removed by the caller (points are not removed
+    //in this function) since we might wan't to keep them for split and ogrids
+    for(size_t i=0;i<edges2rem.size();i++)
     {
-        HexEdge * e= HexEdge::SafeDownCast(edges2rem->GetItemAsObject(i));
-        renderer->RemoveActor(e->actor);
-        edges->RemoveItem(e);
+        HexEdge * e= edges2rem[i];
+        incidence->removeEdge(e);
+        edgeIds2rem->InsertNextId(edges->IsItemPresent(e)-1);
     }
 
-    //remove the patches
     //since patches has pointers to blocks they know if they
-    //should be deleted. We still need to build a list since
-    //we don't want to delete patches while we loop over pathces
-    vtkSmartPointer<vtkIdList> patches2berem =
-            vtkSmartPointer<vtkIdList>::New();
-    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
+    //should be deleted. All patches of the block are in its local list.
+    for(vtkIdType i=0;i<b2rem->localPatches->GetNumberOfItems();i++)
     {
         HexPatch *p = HexPatch::SafeDownCast(
-                    patches->GetItemAsObject(i));
-        if(p->hasBlock(b2rem))
-        {
-            patches2berem->InsertUniqueId(i);
-//            std::cout << "adding patch ( "
-//                      << p->vertIds->GetId(0) << " "
-//                      << p->vertIds->GetId(1) << " "
-//                      << p->vertIds->GetId(2) << " "
-//                      << p->vertIds->GetId(3) << ") to be removed "
-//                      << std::endl;
-        }
-    }
+                    b2rem->localPatches->GetItemAsObject(i));
+        vtkIdType pId = patches->IsItemPresent(p)-1;
+        //not in the global list, e.g. the slave of a merge
+        if(pId < 0 || !p->hasBlock(b2rem))
+            continue;
 
-    //delete the patches
-    for(vtkIdType i=0;i<patches2berem->GetNumberOfIds();i++)
-    {
-        HexPatch *p = HexPatch::SafeDownCast(
-                    patches->GetItemAsObject(patches2berem->GetId(i)));
-//        std::cout << "deleting patch ( "
-//                  << p->vertIds->GetId(0) << " "
-//                  << p->vertIds->GetId(1) << " "
-//                  << p->vertIds->GetId(2) << " "
-//                  << p->vertIds->GetId(3) << ") "
-//                  << std::endl;
         p->removeSafely(b2rem);
         //really delete if patch doesn't have any block left
         //after remove safely
         if(! p->hasBlocks())
         {
-            vtkIdList * cpToRemList = vtkIdList::New();
-            cpToRemList->DeepCopy(patches2berem);
             //delete patches from all bcs
             for(vtkIdType bci=0;bci<hexBCs->GetNumberOfItems();bci++)
             {
                 HexBC * bc = HexBC::SafeDownCast(
                             hexBCs->GetItemAsObject(bci));
                 bc->localPatches->RemoveItem(p);
-                /*
-                bc->patchIds->DeleteId(i);
-                decreaseList(bc->patchIds,i);
-                */
             }
-            renderer->RemoveActor(p->actor);
-            patches->RemoveItem(p);
-            decreaseList(patches2berem,patches2berem->GetId(i));
+            incidence->removePatch(p);
+            patchIds2rem->InsertNextId(pId);
         }
     }
-
-    //delete block
-    renderer->RemoveActor(b2rem->hexAxisActor);
-    renderer->RemoveActor(b2rem->hexBlockActor);
-    hexBlocks->RemoveItem(b2rem);
-    //delete vertices (dont!)
-
 }
 
 void HexBlocker::removeHexBlocks(vtkIdList *toRems)
 {
+    HexUndoStep step(undoStack,"remove blocks");
+    //positions in hexBlocks don't change until all blocks are
+    //detached, then each list is compacted once. The last block is
+    //detached first, so the positions undo stores are the same as if
+    //the blocks were removed one at a time.
+    std::vector<vtkIdType> ids;
     for(vtkIdType i=0;i<toRems->GetNumberOfIds();i++)
     {
-        vtkSmartPointer<vtkIdList> verts2rem =
-                vtkSmartPointer<vtkIdList>::New();
-        removeHexBlock(toRems->GetId(i),verts2rem);
-        removeVerticesSafely(verts2rem);
-        decreaseList(toRems,toRems->GetId(i));
+        vtkIdType id = toRems->GetId(i);
+        if(id >= 0 && id < hexBlocks->GetNumberOfItems())
+            ids.push_back(id);
     }
-}
+    std::sort(ids.begin(),ids.end(),std::greater<vtkIdType>());
+    ids.erase(std::unique(ids.begin(),ids.end()),ids.end());
 
-void HexBlocker::showBlocks()
-{
-    visibilityBlocks(true);
-}
-
-void HexBlocker::hideBlocks()
-{
-    visibilityBlocks(false);
-}
-
-void HexBlocker::visibilityBlocks(bool mode)
-{
-    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
+    std::vector<vtkSmartPointer<HexBlock> > blocks2rem;
+    vtkSmartPointer<vtkIdList> blockIds2rem = vtkSmartPointer<vtkIdList>::New();
+    for(size_t i=0;i<ids.size();i++)
     {
-        HexBlock * hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-        hb->hexBlockActor->SetVisibility(mode);
+        HexBlock *hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(ids[i]));
+        if(hb == NULL)
+            continue;
+        blocks2rem.push_back(hb);
+        blockIds2rem->InsertNextId(ids[i]);
     }
-    //dont show local axis
-//    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
-//    {
-//        HexBlock * hb = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-//        hb->hexAxisActor->SetVisibility(mode);
-//    }
-}
 
-void HexBlocker::showPatches()
-{
-    visibilityPatches(true);
-}
-
-void HexBlocker::hidePatches()
-{
-    visibilityPatches(false);
-}
-
-void HexBlocker::visibilityPatches(bool mode)
-{
-    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
+    vtkSmartPointer<vtkIdList> verts2rem = vtkSmartPointer<vtkIdList>::New();
+    vtkSmartPointer<vtkIdList> edgeIds2rem = vtkSmartPointer<vtkIdList>::New();
+    vtkSmartPointer<vtkIdList> patchIds2rem = vtkSmartPointer<vtkIdList>::New();
+    for(size_t i=0;i<blocks2rem.size();i++)
     {
-        HexPatch *p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
-        p->actor->SetVisibility(mode);
-        p->resetColor();
-    }
-}
-
-void HexBlocker::showEdges()
-{
-    visibilityEdges(true);
-}
-
-void HexBlocker::hideEdges()
-{
-    visibilityEdges(false);
-}
-
-void HexBlocker::visibilityEdges(bool mode)
-{
-    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
-    {
-        HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
-        e->actor->SetVisibility(mode);
+        detachHexBlock(blocks2rem[i],verts2rem,edgeIds2rem,patchIds2rem);
+        //vertices keep their ids until compactVertices
+        for(vtkIdType v=0;v<verts2rem->GetNumberOfIds();v++)
+        {
+            if(!isVerticeUsed(verts2rem->GetId(v)))
+                removeVertice(verts2rem->GetId(v));
+        }
     }
+    edges->removeItems(edgeIds2rem);
+    patches->removeItems(patchIds2rem);
+    hexBlocks->removeItems(blockIds2rem);
 }
 
-void HexBlocker::showVertIDs()
-{
-    visibilityVertIDs(true);
-}
-
-void HexBlocker::hideVertIDs()
-{
-    visibilityVertIDs(false);
-}
-
-void HexBlocker::visibilityVertIDs(bool mode)
+void HexBlocker::render()
 {
-    vertLabelActor->SetVisibility(mode);
+    //nothing to draw on without a view, e.g. in batch runs
+    if(renderCallback != NULL)
+        renderCallback(renderClientData);
 }
 
-void HexBlocker::render()
+void HexBlocker::setRenderCallback(void (*callback)(void *), void *clientData)
 {
-
-    if(isRendering)
-        return;
-    isRendering=true;
-    renderer->Render();
-    renderer->GetRenderWindow()->Render();
-    isRendering=false;
+    renderCallback = callback;
+    renderClientData = clientData;
 }
 
 void HexBlocker::arbitraryTest()
@@ -26,6 +26,8 @@ Description
     This is the main model class. As much as possible that is not GUI or user interaction
     is handled from this class.It's meant to be controlled by MainWindow class but could in principle be used
     alone. It's where all hexBlocks, hexPatches, hexEdges and hexBCs are stored.
+    Nothing is drawn here, HexView draws the model and is told through
+    render() when something has changed.
 */
 
 
@@ -33,45 +35,43 @@ Description
 #define HEXBLOCKER_H
 
 #include <vtkSmartPointer.h>
-#include <vtkSTLReader.h>
+#include <vtkTimeStamp.h>
 #include <QTextStream>
 #include <QString>
+#include <vector>
+#include <set>
+#include <string>
 
 //Predeclarations
 class HexBlock;
 class HexPatch;
+class HexPatchCollection;
 class HexEdge;
+class HexEdgeCollection;
+class HexVertexLocator;
+class HexIncidence;
+class HexEdgeClasses;
+class HexUndoStack;
+class HexBC;
 class HexReader;
+class HexGeometry;
 class vtkPoints;
 class vtkPolyData;
-class vtkGlyph3D;
-class vtkSphereSource;
-class vtkPolyDataMapper;
-class vtkActor;
-class vtkRenderer;
-class vtkCollection;
+class HexCollection;
 class vtkCellArray;
 class vtkQuad;
 class vtkIdList;
-class vtkLabeledDataMapper;
-class vtkActor2D;
-class vtkAxesActor;
-class vtkOrientationMarkerWidget;
-class vtkRenderWindow;
 
 
 class HexBlocker
 {
+    //replays changes through the private functions
+    friend class HexUndoStack;
 public:
     HexBlocker();
     ~HexBlocker();
 
     //FUNCTIONS
-    //inits the global axes
-    void initOrientationAxes(vtkRenderWindow * renwin);
-    //removes the same
-    void removeOrientationAxes();
-
     //create a block from (0,0,0) to (1,1,1)
     void createHexBlock();
 
@@ -89,8 +89,9 @@ public:
     //be used
     void extrudePatch(vtkIdList *selectedPatches, double dist);
 
-    //Sets vertices radius and so on the sensible values depending on
-    //total domain.
+    //resets the edge colours and asks the view to set vertices radius
+    //and so on to sensible values depending on total domain, and to
+    //fit the camera, at next render. See getBoundsMTime.
     void resetBounds();
 
     //Prints blocks, and patches to std::cout
@@ -106,8 +107,30 @@ public:
     //rotate vertices by a given angle around a custom axis
     void rotateVertices(vtkSmartPointer<vtkIdList> ids, double angle, double center[], double axis[]);
 
-    //snap vertices to the closest point on a geometry (read STL surface)
-    void snapVertices(vtkSmartPointer<vtkIdList> ids);
+    //snap vertices to the closest point on geometry geoId, or on any
+    //geometry if geoId is -1 (read STL surfaces).
+    //The search is done on all cores, progress is called now and then with
+    //the fraction done and may return false to cancel, see HexSurfaceLocator.
+    //Returns false if cancelled, no vertice is then moved.
+    bool snapVertices(vtkSmartPointer<vtkIdList> ids, vtkIdType geoId=-1,
+                      bool (*progress)(double, void *)=NULL, void *clientData=NULL);
+    //as above but to the closest point on the feature curves of the
+    //geometry, e.g. sharp edges, see HexGeometry
+    bool snapVerticesToFeatures(vtkSmartPointer<vtkIdList> ids, vtkIdType geoId=-1,
+                                bool (*progress)(double, void *)=NULL, void *clientData=NULL);
+
+    //moves the control point of the arcs among edgeIds to the closest
+    //feature curve of geometry geoId, or of any geometry if -1.
+    //Lines are skipped.
+    void snapArcsToFeatures(vtkIdList *edgeIds, vtkIdType geoId=-1);
+
+    //feature angle in degrees of all geometries, see HexGeometry
+    void setFeatureAngle(double angle);
+
+    //vertices closer than tol are merged when new vertices are created,
+    //e.g. by create block, extrude and split.
+    void setMergeTolerance(double tol);
+    double getMergeTolerance();
 
     //resets colors for patches and edges.
     void resetColors();
@@ -129,6 +152,26 @@ public:
     // mode=2 only to block that owns the edge (not yet implemented)
     void setEdgePropsOnParallelEdges(HexEdge *props,vtkIdType edgeId, int mode=0);
 
+    //adds the patches with ids in the global list to bc
+    void setBCPatches(HexBC *bc, vtkIdList *patchIds);
+
+    //create, rename and remove BCs so it can be undone
+    HexBC * createBC(const std::string &name, const std::string &type);
+    void setBCName(HexBC *bc, const std::string &name, const std::string &type);
+    void removeBC(HexBC *bc);
+
+    //set the type of an edge (0 line, 1 arc) or the control point of
+    //an arc, so it can be undone. Lines have no control point.
+    void setEdgeType(HexEdge *e, int type);
+    void setArcControlPoint(HexEdge *e, const double pos[3]);
+    //the control point is computed from the center and radius, see
+    //HexEdge::calcArcControlPointFromCenter
+    void setArcFromCenter(HexEdge *e, const double center[3], double radius=0.0);
+
+    //undo/redo the last change to the model, false if there is none
+    bool undo();
+    bool redo();
+
     //nx*ny*nz is sumed for all blocks
     int calculateTotalNumberOfCells();
 
@@ -136,8 +179,11 @@ public:
     //from reader
     void readBlockMeshDict(HexReader * reader);
 
-    //Reads a STL geometry
-    void readGeometry(char *openFileName);
+    //Reads a STL geometry and adds it to the geometries,
+    //false if it couldn't be read
+    bool readGeometry(char *openFileName);
+    //removes geometry geoId
+    void removeGeometry(vtkIdType geoId);
 
     //Merges two patches but only if they match
     //i.e. each vertice in master must have
@@ -145,25 +191,43 @@ public:
     void mergePatch(vtkIdType masterId, vtkIdType slaveId);
 
     // Return true if vertice was removed. Only remove of no block
-    // has vertices id toRem
+    // has vertices id toRem. Removed vertices keep their ids and are
+    // hidden until compactVertices.
     bool removeVerticeSafely(vtkIdType toRem);
     void removeVerticesSafely(vtkIdList * toRemove);
 
+    // Drops the removed vertices that no block uses (again) and renumbers
+    // the rest to 0..N-1 in one pass over edges, patches and blocks.
+    // Done before export, or when asked for; removing never does it.
+    void compactVertices();
+
+    // true if vertice id has been removed and is not used by any block,
+    // it is then not drawn and dropped by compactVertices
+    bool isVerticeRemoved(vtkIdType id);
+    // last change of the removed vertices
+    unsigned long getRemovedVerticesMTime();
+
     // remove a block and any patch or edge that has vertices
     // that are no longer needed by any block.
     // it does not remove vertices
     void removeHexBlock(vtkIdType toRem);
 
-    // redraw all actors and render
+    // redraw all blocks, patches and edges and render. Use when it's
+    // not known which vertices have moved.
     void rescaleActors();
 
     //As above but fill vertsToRem with vertices that are no longer needed.
     void removeHexBlock(const vtkIdType toRem, vtkIdList * vertsToRem);
+    void removeHexBlock(HexBlock *b2rem, vtkIdList * vertsToRem);
     //this is a testfunktion for quick and dirty testing
     //and devloping
 
     // calls removeHexBlock(toRem,vert2rem) for every item in list
-    // ie removes all blocks in hte list and their vertices
+    // ie removes all blocks in hte list and their vertices.
+    // Blocks, patches, edges and BCs refer to each other by pointer,
+    // which is their stable handle, and to vertices by id. So only
+    // vertices need tombstones; the other lists are compacted once
+    // per call, whatever the number of blocks.
     void removeHexBlocks(vtkIdList * toRems);
     void arbitraryTest();
 
@@ -173,66 +237,95 @@ public:
     //a tentative algorithm to reorder vertices before creating a HexBlock.
     void orderVertices(vtkIdList *selectedVertices);
 
-    //show/hide objects
-    void showBlocks();
-    void hideBlocks();
-    void visibilityBlocks(bool mode);
-    void showPatches();
-    void hidePatches();
-    void visibilityPatches(bool mode);
-    void showEdges();
-    void hideEdges();
-    void visibilityEdges(bool mode);
-    void showVertIDs();
-    void hideVertIDs();
-    void visibilityVertIDs(bool mode);
+    //show/hide geometries, the rest is shown or hidden by HexView
     void showGeometry();
     void hideGeometry();
     void visibilityGeometry(bool mode);
+    void visibilityGeometry(vtkIdType geoId, bool mode);
 
     //set model scale; related to convertToMeters in blockMeshDict
     void setModelScale(double scale);
+    //scale all geometries or geometry geoId
     void scaleGeometry(double scale);
+    void scaleGeometry(vtkIdType geoId, double scale);
     double convertToMeters;
-    double geoScale;
-    bool hasGeometry;
+    double geoScale; //last scale of all geometries
+    double featureAngle; //last feature angle of all geometries
 
-    //force a render
+    //asks the view to render, does nothing if there is no view.
+    //Called after every change of the model.
     void render();
+    //callback is called with clientData by render(), NULL for none
+    void setRenderCallback(void (*callback)(void *), void *clientData);
+
+    //last call of resetBounds
+    unsigned long getBoundsMTime();
+    //the vertices removed but not yet compacted, some may be used again
+    const std::set<vtkIdType> & getRemovedVertices();
 
     //DATA
     vtkSmartPointer<vtkPoints> vertices;
     vtkSmartPointer<vtkPolyData> vertData;
-    vtkSmartPointer<vtkCollection> patches; //global patch list
-    vtkSmartPointer<vtkCollection> hexBlocks;
-    vtkSmartPointer<vtkCollection> hexBCs; //BCs
-    vtkSmartPointer<vtkCollection> edges; //global list of edges
-
-    //Representations
-    vtkSmartPointer<vtkSphereSource> vertSphere;
-    vtkSmartPointer<vtkGlyph3D> vertGlyph;
-    vtkSmartPointer<vtkPolyDataMapper> vertMapper;
-    vtkSmartPointer<vtkActor> vertActor;
-    vtkSmartPointer<vtkActor> GeoActor;
-    vtkSmartPointer<vtkSTLReader> GeoReader;
-    vtkSmartPointer<vtkAxesActor> orientationAxes;
-    vtkSmartPointer<vtkOrientationMarkerWidget> orientationAxesWidget;
-    vtkSmartPointer<vtkLabeledDataMapper> vertLabelMapper;
-    vtkSmartPointer<vtkActor2D> vertLabelActor;
-    vtkSmartPointer<vtkRenderer> renderer;
+    vtkSmartPointer<HexPatchCollection> patches; //global patch list
+    vtkSmartPointer<HexCollection> hexBlocks;
+    vtkSmartPointer<HexCollection> hexBCs; //BCs
+    vtkSmartPointer<HexEdgeCollection> edges; //global list of edges
+    vtkSmartPointer<HexVertexLocator> vertLocator; //finds vertices by position
+    vtkSmartPointer<HexIncidence> incidence; //vertice/edge to block, patch, edge
+    vtkSmartPointer<HexEdgeClasses> edgeClasses; //classes of parallel edges
+    vtkSmartPointer<HexUndoStack> undoStack; //changes that can be undone
+    vtkSmartPointer<HexCollection> geometries; //read STL surfaces, see HexGeometry
 
     //to be removed, has info of arcs and such
     QString edgesDict;
 
 private:
     //Functions
+    //appends the edges parallel to edgeId that are not already in the list
     void addParallelEdges(vtkSmartPointer<vtkIdList> allParallelEdges,vtkIdType edgeId);
     // returns id if found else returns -1
     vtkIdType findEdge(const vtkIdType a, const vtkIdType b);
 
+    // the closest point for each of the n points in pos on the surfaces,
+    // or the feature curves, of geometry geoId or all if -1. Returns the
+    // number of geometries searched, 0 leaves closest untouched, or -1
+    // if progress cancelled.
+    vtkIdType findClosestOnGeometries(vtkIdType n, const double *pos, double *closest,
+                                      vtkIdType geoId, bool features,
+                                      bool (*progress)(double, void *)=NULL,
+                                      void *clientData=NULL);
+    // snapVertices and snapVerticesToFeatures
+    bool snapVerticesTo(vtkSmartPointer<vtkIdList> ids, vtkIdType geoId, bool features,
+                        bool (*progress)(double, void *), void *clientData);
+
+    // adds a block on eight ordered vertices with its edges and patches,
+    // without resetting the bounds or rendering, e.g. when undo puts
+    // back several blocks
+    HexBlock * insertHexBlock(vtkIdList *verts);
+    // the part of addHexBlockFeatures done for every block
+    void attachHexBlock(HexBlock *hex, vtkIdType numEdges, vtkIdType numPatches);
+
+    // sets the position of a vertice, the change can be undone
+    void setVertice(vtkIdType id, double pos[3]);
+
+    // redraws the edges, patches and blocks that use vertices moved
+    // by setVertice since the last redraw, and renders
+    void redrawMovedVertices();
+
+    // true if any block uses vertice vId
+    bool isVerticeUsed(vtkIdType vId);
+
+    // marks vertices as removed, ids are kept until compactVertices
     void removeVertice(vtkIdType toRem);
     void removeVertices(vtkIdList * toRemove);
 
+    // takes a block out of the incidence tables, the undo stack and
+    // the patches and BCs, and appends the positions of its edges and
+    // patches that no other block uses. The lists are not changed, so
+    // several blocks can be removed with one pass over each list.
+    void detachHexBlock(HexBlock *b2rem, vtkIdList *vertsToRem,
+                        vtkIdList *edgeIds2rem, vtkIdList *patchIds2rem);
+
     /* decreases Ids > toRem (not equal to toRem)
      these are used when deleting while traversing a list
      For instance lets say we have the list org(10 11 12 13 14) and
@@ -251,7 +344,14 @@ private:
     void decreaseList(vtkIdList * list, vtkIdType toRem);
 
     //DATA
-    bool isRendering;
+    void (*renderCallback)(void *);
+    void *renderClientData;
+    vtkTimeStamp boundsTime; //last call of resetBounds
+    //vertices to be removed by compactVertices
+    std::set<vtkIdType> removedVertices;
+    vtkTimeStamp removedTime; //last change of removedVertices
+    //vertices moved since the last redraw
+    std::vector<vtkIdType> movedVertices;
 };
 
 
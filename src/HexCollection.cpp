@@ -0,0 +1,204 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexCollection.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+#include <algorithm>
+
+vtkStandardNewMacro(HexCollection);
+
+HexCollection::HexCollection()
+{
+
+}
+
+HexCollection::~HexCollection()
+{
+    RemoveAllItems();
+}
+
+void HexCollection::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "items: " << items.size()
+       << ", distinct: " << positions.size() << std::endl;
+}
+
+int HexCollection::GetNumberOfItems()
+{
+    return static_cast<int>(items.size());
+}
+
+vtkObject * HexCollection::GetItemAsObject(int i)
+{
+    if(i < 0 || i >= GetNumberOfItems())
+        return NULL;
+    return items[i];
+}
+
+void HexCollection::AddItem(vtkObject *a)
+{
+    items.push_back(a);
+    a->Register(this);
+    //we keep the first occurence
+    if(!positions.contains(a))
+        positions.insert(a,vtkIdType(items.size()-1));
+    itemAdded(a);
+    this->Modified();
+}
+
+void HexCollection::InsertItem(int i, vtkObject *a)
+{
+    if(i >= GetNumberOfItems() || items.empty())
+        return;
+    vtkIdType pos = i < 0 ? 0 : i+1;
+    unmapFrom(pos);
+    items.insert(items.begin()+pos,a);
+    a->Register(this);
+    mapFrom(pos);
+    itemAdded(a);
+    this->Modified();
+}
+
+void HexCollection::ReplaceItem(int i, vtkObject *a)
+{
+    if(i < 0 || i >= GetNumberOfItems())
+        return;
+    vtkObject *old = items[i];
+    itemRemoved(old);
+    //old may occur again later and a may become a first occurence
+    unmapFrom(i);
+    items[i] = a;
+    a->Register(this);
+    mapFrom(i);
+    itemAdded(a);
+    old->UnRegister(this);
+    this->Modified();
+}
+
+void HexCollection::RemoveItem(int i)
+{
+    if(i < 0 || i >= GetNumberOfItems())
+        return;
+    vtkObject *a = items[i];
+    itemRemoved(a);
+    unmapFrom(i);
+    items.erase(items.begin()+i);
+    mapFrom(i);
+    a->UnRegister(this);
+    this->Modified();
+}
+
+void HexCollection::RemoveItem(vtkObject *a)
+{
+    RemoveItem(static_cast<int>(findItem(a)));
+}
+
+void HexCollection::RemoveAllItems()
+{
+    //clear before unregistering, the items may be deleted
+    std::vector<vtkObject *> old;
+    old.swap(items);
+    positions.clear();
+    for(size_t i=0;i<old.size();i++)
+    {
+        itemRemoved(old[i]);
+        old[i]->UnRegister(this);
+    }
+    if(!old.empty())
+        this->Modified();
+}
+
+int HexCollection::IsItemPresent(vtkObject *a)
+{
+    return static_cast<int>(findItem(a)+1);
+}
+
+void HexCollection::removeItems(vtkIdList *ids)
+{
+    vtkIdType n = items.size();
+    std::vector<bool> toRem(n,false);
+    vtkIdType start = n;
+    for(vtkIdType i=0;i<ids->GetNumberOfIds();i++)
+    {
+        vtkIdType id = ids->GetId(i);
+        if(id < 0 || id >= n)
+            continue;
+        toRem[id] = true;
+        if(id < start)
+            start = id;
+    }
+    if(start == n)
+        return;
+
+    unmapFrom(start);
+    std::vector<vtkObject *> removed;
+    vtkIdType w = start;
+    for(vtkIdType r=start;r<n;r++)
+    {
+        if(toRem[r])
+        {
+            itemRemoved(items[r]);
+            removed.push_back(items[r]);
+        }
+        else
+            items[w++] = items[r];
+    }
+    items.resize(w);
+    mapFrom(start);
+
+    for(size_t i=0;i<removed.size();i++)
+        removed[i]->UnRegister(this);
+    this->Modified();
+}
+
+void HexCollection::unmapFrom(vtkIdType start)
+{
+    //items here whose first occurence is earlier keep their position
+    for(vtkIdType j=start;j<vtkIdType(items.size());j++)
+    {
+        QHash<vtkObject *,vtkIdType>::iterator it = positions.find(items[j]);
+        if(it != positions.end() && it.value() >= start)
+            positions.erase(it);
+    }
+}
+
+void HexCollection::mapFrom(vtkIdType start)
+{
+    for(vtkIdType j=start;j<vtkIdType(items.size());j++)
+    {
+        if(!positions.contains(items[j]))
+            positions.insert(items[j],j);
+    }
+}
+
+vtkIdType HexCollection::findItem(vtkObject *a)
+{
+    QHash<vtkObject *,vtkIdType>::const_iterator it = positions.constFind(a);
+    if(it == positions.constEnd())
+        return -1;
+    return it.value();
+}
@@ -0,0 +1,99 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    A replacement for vtkCollection used for the lists in the model
+    (blocks, patches, edges and BCs). vtkCollection is a linked list, so
+    GetItemAsObject(i) walks i items and a loop over all items is
+    quadratic. This class has the same interface but stores the items
+    in a vector and keeps a hash from item to position, so
+    GetItemAsObject and IsItemPresent are constant time. Removing or
+    inserting in the middle moves the items after that point, their
+    positions are updated in the same pass.
+    Items are reference counted just as in vtkCollection.
+*/
+
+#ifndef HEXCOLLECTION_H
+#define HEXCOLLECTION_H
+
+#include <vtkObject.h>
+#include <QHash>
+#include <vector>
+
+class vtkIdList;
+
+class HexCollection : public vtkObject
+{
+    vtkTypeMacro(HexCollection,vtkObject)
+
+protected:
+    HexCollection();
+    ~HexCollection();
+    HexCollection(const HexCollection&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexCollection&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexCollection *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //same meaning as in vtkCollection
+    int GetNumberOfItems();
+    vtkObject * GetItemAsObject(int i);
+    void AddItem(vtkObject *a);
+    //inserts after the i'th item, as vtkCollection does
+    void InsertItem(int i, vtkObject *a);
+    void ReplaceItem(int i, vtkObject *a);
+    void RemoveItem(int i);
+    void RemoveItem(vtkObject *a);
+    void RemoveAllItems();
+    //returns position+1 of the item or 0 if not present. If the item
+    //is in the list more than once it's the first occurence.
+    int IsItemPresent(vtkObject *a);
+
+    //removes the items at the positions in ids with a single pass
+    //over the list. Positions refer to the list before the removal.
+    void removeItems(vtkIdList *ids);
+
+protected:
+    //called for every item put in or taken out of the list, from
+    //every function that changes it, for subclasses that index the items
+    virtual void itemAdded(vtkObject *) {}
+    virtual void itemRemoved(vtkObject *) {}
+
+    //forgets the positions from start on, before the items there move
+    void unmapFrom(vtkIdType start);
+    //sets the positions from start on, after the items there have moved
+    void mapFrom(vtkIdType start);
+    //position of a, -1 if not present
+    vtkIdType findItem(vtkObject *a);
+
+    //DATA
+    std::vector<vtkObject *> items;
+    //first position of every item
+    QHash<vtkObject *,vtkIdType> positions;
+};
+
+#endif // HEXCOLLECTION_H
@@ -0,0 +1,106 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexDirtyItems.h"
+#include "HexCollection.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkCallbackCommand.h>
+#include <vtkCommand.h>
+#include <algorithm>
+
+vtkStandardNewMacro(HexDirtyItems);
+
+HexDirtyItems::HexDirtyItems()
+{
+    callback = vtkSmartPointer<vtkCallbackCommand>::New();
+    callback->SetCallback(HexDirtyItems::itemModified);
+    callback->SetClientData(this);
+}
+
+HexDirtyItems::~HexDirtyItems()
+{
+    unwatch();
+    //in case an item still calls it
+    callback->SetClientData(NULL);
+}
+
+void HexDirtyItems::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "watched: " << watched.size()
+       << ", dirty: " << dirty.size() << std::endl;
+}
+
+void HexDirtyItems::watch(HexCollection *l)
+{
+    unwatch();
+    list = l;
+    if(list == NULL)
+        return;
+    vtkIdType n = list->GetNumberOfItems();
+    watched.reserve(n);
+    for(vtkIdType i=0;i<n;i++)
+    {
+        vtkObject *item = list->GetItemAsObject(i);
+        unsigned long tag = item->AddObserver(vtkCommand::ModifiedEvent,callback);
+        watched.push_back(std::make_pair(vtkWeakPointer<vtkObject>(item),tag));
+    }
+}
+
+void HexDirtyItems::unwatch()
+{
+    for(size_t i=0;i<watched.size();i++)
+    {
+        vtkObject *item = watched[i].first;
+        if(item != NULL)
+            item->RemoveObserver(watched[i].second);
+    }
+    watched.clear();
+    dirty.clear();
+}
+
+void HexDirtyItems::takeDirty(std::vector<vtkIdType> &ids)
+{
+    ids.clear();
+    if(list == NULL)
+        return;
+    for(std::set<vtkObject *>::iterator it=dirty.begin();it!=dirty.end();++it)
+    {
+        //only compares the pointer, the item may be gone from the list
+        vtkIdType pos = list->IsItemPresent(*it)-1;
+        if(pos >= 0)
+            ids.push_back(pos);
+    }
+    dirty.clear();
+    std::sort(ids.begin(),ids.end());
+}
+
+void HexDirtyItems::itemModified(vtkObject *caller, unsigned long,
+                                 void *clientData, void *)
+{
+    HexDirtyItems *self = static_cast<HexDirtyItems *>(clientData);
+    if(self != NULL)
+        self->dirty.insert(caller);
+}
@@ -0,0 +1,84 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Remembers which items of a HexCollection have been modified since
+    they were last asked for, so a representation can update those and
+    doesn't have to walk the whole list. Every item gets an observer of
+    ModifiedEvent when the list is watched; items added later are not
+    seen, a representation watches the list again when it has changed.
+*/
+
+#ifndef HEXDIRTYITEMS_H
+#define HEXDIRTYITEMS_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+#include <vector>
+#include <set>
+
+class HexCollection;
+class vtkCallbackCommand;
+
+class HexDirtyItems : public vtkObject
+{
+    vtkTypeMacro(HexDirtyItems,vtkObject)
+
+protected:
+    HexDirtyItems();
+    ~HexDirtyItems();
+    HexDirtyItems(const HexDirtyItems&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexDirtyItems&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexDirtyItems *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //observes the items now in list and forgets the ones watched
+    //before. No item is dirty afterwards.
+    void watch(HexCollection *list);
+
+    //fills ids with the positions in the list of the items modified
+    //since watch or the last call, in increasing order, and clears them.
+    void takeDirty(std::vector<vtkIdType> &ids);
+
+private:
+    //FUNCTIONS
+    void unwatch();
+    static void itemModified(vtkObject *caller, unsigned long eid,
+                             void *clientData, void *callData);
+
+    //DATA
+    vtkSmartPointer<HexCollection> list;
+    vtkSmartPointer<vtkCallbackCommand> callback;
+    //the observed items and the observer tags, an item may have been
+    //deleted since so they are held by weak pointers
+    std::vector<std::pair<vtkWeakPointer<vtkObject>,unsigned long> > watched;
+    std::set<vtkObject *> dirty;
+};
+
+#endif // HEXDIRTYITEMS_H
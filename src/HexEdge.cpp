@@ -29,14 +29,8 @@ License
 
 #include <vtkIdList.h>
 #include <vtkPoints.h>
-#include <vtkLine.h>
-#include <vtkCellArray.h>
-#include <vtkPolyData.h>
-#include <vtkPolyDataMapper.h>
-#include <vtkActor.h>
-#include <vtkProperty.h>
 #include <vtkMath.h>
-#include <vtkTubeFilter.h>
+#include <cmath>
 
 
 vtkStandardNewMacro(HexEdge);
@@ -47,20 +41,17 @@ HexEdge::HexEdge()
     vertIds->SetNumberOfIds(2);
     edgeType=LINE;
 
-    data = vtkSmartPointer<vtkPolyData>::New();
-    lines = vtkSmartPointer<vtkCellArray>::New();
-    tube = vtkSmartPointer<vtkTubeFilter>::New();
-    tube->SetNumberOfSides(24);
-    mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    actor  = vtkSmartPointer<vtkActor>::New();
+    resetColor();
 
     nCells = 10; //default value
     grading = 1.0; //default value
 
     arcNpoints=50;
+    arcFrameValid=false;
+    arcRadius=0.0;
 
     myPoints = vtkSmartPointer<vtkPoints>::New();
-    cntrlPointsIds = vtkSmartPointer<vtkIdList>::New();
+    cntrlPoints = vtkSmartPointer<vtkPoints>::New();
 
 }
 
@@ -123,35 +114,21 @@ void HexEdge::init(vtkIdType p0,
     setType(LINE);
     drawLine();
 
-    data->SetPoints(myPoints);
-    data->SetLines(lines);
-
-#if VTK_MAJOR_VERSION >= 6
-    tube->SetInputData(data);
-#else
-    tube->SetInput(data);
-#endif    
-    tube->SetRadius(0.05);
-    mapper->SetInputConnection(tube->GetOutputPort());
-
-    actor->SetMapper(mapper);
-
     resetColor();
 }
 
 void HexEdge::setColor(double r, double g, double b)
 {
-    actor->GetProperty()->SetColor(r,b,g);
+    color[0]=r;
+    color[1]=g;
+    color[2]=b;
+    //the representation redraws modified edges
+    this->Modified();
 }
 
 void HexEdge::resetColor()
 {
-    actor->GetProperty()->SetColor(0.8,0.9,0.8);
-}
-
-void HexEdge::setRadius(double rad)
-{
-    tube->SetRadius(rad);
+    setColor(0.8,0.9,0.8);
 }
 
 void HexEdge::exportVertIds(QTextStream &os)
@@ -178,11 +155,11 @@ void HexEdge::exportEdgeDict(QTextStream &os)
 
     }
     os << vertIds->GetId(0) << " " <<vertIds->GetId(1) << " ";
-    int numPoints = cntrlPointsIds->GetNumberOfIds();
+    int numPoints = cntrlPoints->GetNumberOfPoints();
     if(numPoints == 1)
     {
         double pos[3];
-        myPoints->GetPoint(cntrlPointsIds->GetId(0),pos);
+        cntrlPoints->GetPoint(0,pos);
         os << "(" << pos[0] << " " << pos[1] << " " << pos[2] << ") " <<endl;
     }
     else
@@ -191,7 +168,7 @@ void HexEdge::exportEdgeDict(QTextStream &os)
         for(vtkIdType i=0;i<numPoints;i++)
         {
             double pos[3];
-            myPoints->GetPoint(cntrlPointsIds->GetId(0),pos);
+            cntrlPoints->GetPoint(i,pos);
             os << "\t\t(" << pos[0] << " " << pos[1] << " " << pos[2] << ")" <<endl;
         }
         os << "\t)"<<endl;
@@ -208,14 +185,14 @@ void HexEdge::changeVertId(vtkIdType from, vtkIdType to)
 
 }
 
-void HexEdge::reduceVertId(vtkIdType vId)
+void HexEdge::remapVertIds(const std::vector<vtkIdType> &newIds)
 {
     for(vtkIdType i=0;i<vertIds->GetNumberOfIds();i++)
     {
         vtkIdType oldId = vertIds->GetId(i);
-        if(oldId > vId)
+        if(oldId < vtkIdType(newIds.size()))
         {
-            vertIds->SetId(i,oldId-1);
+            vertIds->SetId(i,newIds[oldId]);
         }
     }
 }
@@ -247,8 +224,8 @@ void HexEdge::setType(edgeTypes newType)
     globalVertices->GetPoint(vertIds->GetId(1),pc1);
 
     myPoints->Initialize();
-    lines->Initialize();
-    cntrlPointsIds->Initialize();
+    cntrlPoints->Initialize();
+    arcFrameValid=false;
 
     edgeType=newType;
     switch(edgeType)
@@ -258,16 +235,14 @@ void HexEdge::setType(edgeTypes newType)
         myPoints->SetNumberOfPoints(2);
         myPoints->SetPoint(0,pc0);
         myPoints->SetPoint(1,pc1);
-        cntrlPointsIds->SetNumberOfIds(0);
     }
         break;
     case ARC:
     {
-        myPoints->SetNumberOfPoints(arcNpoints);
+        //the points on the arc are computed when it's drawn
+        myPoints->SetNumberOfPoints(2);
         myPoints->SetPoint(0,pc0);
-        cntrlPointsIds->SetNumberOfIds(1);
-        cntrlPointsIds->InsertId(0,arcNpoints/2);
-        myPoints->SetPoint(arcNpoints-1,pc1);
+        myPoints->SetPoint(1,pc1);
         //create an initial random arcppoint, so the three points are not inline
         double p[3];
         calcParametricPointOnLine(0.5,p);
@@ -278,7 +253,8 @@ void HexEdge::setType(edgeTypes newType)
         vtkMath::MultiplyScalar(rand,1e-5);
         double arcp[3];
         vtkMath::Add(rand,p,arcp);
-        myPoints->SetPoint(cntrlPointsIds->GetId(0),arcp);
+        cntrlPoints->SetNumberOfPoints(1);
+        cntrlPoints->SetPoint(0,arcp);
     }
         break;
     default:
@@ -321,25 +297,21 @@ void HexEdge::redrawedge()
         drawLine();
         break;
     case ARC:
-        double c[3],arcpnt[3];
-        myPoints->GetPoint(cntrlPointsIds->GetId(0),arcpnt);
+        double arcpnt[3];
+        cntrlPoints->GetPoint(0,arcpnt);
         //new arcp = oldarcp + t*delta0 +(1-t)*delta1
         double t = calcParameterFromId(0);
         vtkMath::MultiplyScalar(delta0,t);
         vtkMath::MultiplyScalar(delta1,1-t);
         vtkMath::Add(delta0,arcpnt,arcpnt);
         vtkMath::Add(delta1,arcpnt,arcpnt);
+        cntrlPoints->SetPoint(0,arcpnt);
 
-        //Store the new points
-        myPoints->SetPoint(0,gp0);
-        myPoints->SetPoint(cntrlPointsIds->GetId(0),arcpnt);
-        myPoints->SetPoint(arcNpoints-1,gp1);
-        vtkMath::Solve3PointCircle(gp0,arcpnt,gp1,c);
-        drawArc(c);
+        setArcFrame(arcpnt);
+        drawLine();
         break;
     }
-    data->Modified();
-    tube->Modified();
+    this->Modified();
 }
 
 void HexEdge::drawLine()
@@ -352,49 +324,98 @@ void HexEdge::drawLine()
 
     myPoints->SetPoint(0,pc0);
     myPoints->SetPoint(1,pc1);
+}
+
+vtkIdType HexEdge::getNumberOfDrawPoints(double tol)
+{
+    if(edgeType == ARC)
+        return calcArcNpoints(tol);
+    return 2;
+}
+
+void HexEdge::getDrawPoints(double tol, vtkPoints *pts, vtkIdType offset)
+{
+    if(edgeType != ARC)
+    {
+        pts->SetPoint(offset,myPoints->GetPoint(0));
+        pts->SetPoint(offset+1,myPoints->GetPoint(1));
+        return;
+    }
 
-    vtkSmartPointer<vtkLine> line =
-            vtkSmartPointer<vtkLine>::New();
-    line->GetPointIds()->SetId(0,0);
-    line->GetPointIds()->SetId(1,1);
-    lines->Initialize();
-    lines->InsertNextCell(line);
+    //all points are written from the cached circle
+    updateArcFrame();
+    vtkIdType n = calcArcNpoints(tol);
+    pts->SetPoint(offset,arcEnds[0]);
+    for(vtkIdType i=1;i<n-1;i++)
+    {
+        double t=i /((double)(n-1));
+        double arcp[3];
+        pointOnArc(t,arcCenter,arcRadius,arcEnds[0],arcEnds[1],arcp);
+        pts->SetPoint(offset+i,arcp);
+    }
+    pts->SetPoint(offset+n-1,arcEnds[1]);
 }
 
-void HexEdge::drawArc(double c[3])
+void HexEdge::setArcFrame(const double arcp[3])
 {
-    edgeType=ARC;
+    globalVertices->GetPoint(vertIds->GetId(0),arcEnds[0]);
+    globalVertices->GetPoint(vertIds->GetId(1),arcEnds[1]);
+    vtkMath::Solve3PointCircle(arcEnds[0],arcp,arcEnds[1],arcCenter);
+
+    //R = (|u| + |v|)/2 average value
+    double u[3],v[3];
+    vtkMath::Subtract(arcEnds[0],arcCenter,u);
+    vtkMath::Subtract(arcEnds[1],arcCenter,v);
+    arcRadius = 0.5 * (vtkMath::Norm(u) + vtkMath::Norm(v));
+    arcFrameValid=true;
+}
 
+void HexEdge::updateArcFrame()
+{
     double pc0[3], pc1[3];
     globalVertices->GetPoint(vertIds->GetId(0),pc0);
     globalVertices->GetPoint(vertIds->GetId(1),pc1);
+    if(arcFrameValid &&
+            pc0[0]==arcEnds[0][0] && pc0[1]==arcEnds[0][1] && pc0[2]==arcEnds[0][2] &&
+            pc1[0]==arcEnds[1][0] && pc1[1]==arcEnds[1][1] && pc1[2]==arcEnds[1][2])
+        return;
 
-    lines->Initialize();
-
-    //insert first vertice
-    myPoints->SetPoint(0,pc0);
+    double arcp[3];
+    cntrlPoints->GetPoint(0,arcp);
+    setArcFrame(arcp);
+}
 
-    for(vtkIdType i=1;i<arcNpoints-1;i++)
-    {
-        double t=i /((double)(arcNpoints-1));
-        double arcp[3];
-        calcParametricPointOnArc(t,c,arcp);
-        myPoints->SetPoint(i,arcp);
-        vtkSmartPointer<vtkLine> line =
-                vtkSmartPointer<vtkLine>::New();
-        line->GetPointIds()->SetId(0,i-1);
-        line->GetPointIds()->SetId(1,i);
-        lines->InsertNextCell(line);
-    }
-//    myPoints->SetPoint(arcNpoints-1,pc1); //redundant
-    vtkSmartPointer<vtkLine> line =
-            vtkSmartPointer<vtkLine>::New();
-    line->GetPointIds()->SetId(0,arcNpoints-2);
-    line->GetPointIds()->SetId(1,arcNpoints-1);
-    lines->InsertNextCell(line);
+int HexEdge::calcArcNpoints(double tol)
+{
+    if(tol <= 0.0)
+        return arcNpoints;
+    updateArcFrame();
+    if(!(arcRadius > tol))
+        return 3;
 
-    lines->Modified();
-    tube->Modified();
+    //angle of the arc
+    double u[3],v[3];
+    vtkMath::Subtract(arcEnds[0],arcCenter,u);
+    vtkMath::Subtract(arcEnds[1],arcCenter,v);
+    vtkMath::Normalize(u);
+    vtkMath::Normalize(v);
+    double dotp = vtkMath::Dot(u,v);
+    dotp = dotp > 1.0 ? 1.0 : (dotp < -1.0 ? -1.0 : dotp);
+    double theta = std::acos(dotp);
+
+    //largest angle of a segment with a distance to the arc below
+    //tol. Points are evenly spaced on the chord, so the
+    //segments in the middle are the longest, 2*tan(theta/2) times
+    //the angle per step of t.
+    double dphi = 2.0*std::acos(1.0-tol/arcRadius);
+    double segs = std::ceil(2.0*std::tan(0.5*theta)/dphi);
+
+    //at least one point between the ends, for the control point
+    if(!(segs < 199.0))
+        return 200;
+    if(segs < 2.0)
+        return 3;
+    return int(segs)+1;
 }
 
 void HexEdge::calcParametricPoint(const double t, double pt[])
@@ -424,12 +445,8 @@ void HexEdge::calcParametricPointOnLine(const double t, double pt[3])
 
 void HexEdge::calcParametricPointOnArc(const double t, double pt[])
 {
-    double center[3],arcp[3],pc0[3],pc1[3];
-    globalVertices->GetPoint(vertIds->GetId(0),pc0); //tail
-    globalVertices->GetPoint(vertIds->GetId(1),pc1); //head
-    myPoints->GetPoint(cntrlPointsIds->GetId(0),arcp);
-    vtkMath::Solve3PointCircle(pc1,arcp,pc0,center);
-    calcParametricPointOnArc(t,center,pt);
+    updateArcFrame();
+    pointOnArc(t,arcCenter,arcRadius,arcEnds[0],arcEnds[1],pt);
 }
 
 double HexEdge::calcParameterFromId(vtkIdType cntlId)
@@ -442,7 +459,7 @@ double HexEdge::calcParameterFromId(vtkIdType cntlId)
         double center[3],arcp[3],pc0[3],pc1[3];
         globalVertices->GetPoint(vertIds->GetId(0),pc0); //tail
         globalVertices->GetPoint(vertIds->GetId(1),pc1); //head
-        myPoints->GetPoint(cntrlPointsIds->GetId(0),arcp);
+        cntrlPoints->GetPoint(0,arcp);
         vtkMath::Solve3PointCircle(pc1,arcp,pc0,center);
 
         double u[3],v[3],w[3];
@@ -478,11 +495,16 @@ void HexEdge::calcParametricPointOnArc(const double t, const double c[3], double
     //R = (|u| + |v|)/2 average value
     double R = 0.5 * (vtkMath::Norm(u) + vtkMath::Norm(v) );
 
-    double pt[3]; //parametric point on straight line
-    calcParametricPointOnLine(t,pt);
+    pointOnArc(t,c,R,pc0,pc1,arcp);
+}
 
-    double z[3];
-    vtkMath::Subtract(pt,c,z); //z=pt-c
+void HexEdge::pointOnArc(const double t, const double c[3], const double R,
+                         const double p0[3], const double p1[3], double arcp[3])
+{
+    double z[3]; //z=pt-c, pt on the straight line
+    z[0]=t*p1[0] + (1-t)*p0[0] - c[0];
+    z[1]=t*p1[1] + (1-t)*p0[1] - c[1];
+    z[2]=t*p1[2] + (1-t)*p0[2] - c[2];
     double nz=vtkMath::Norm(z);
 
     arcp[0] = c[0] + R*z[0]/nz;
@@ -493,7 +515,7 @@ void HexEdge::calcParametricPointOnArc(const double t, const double c[3], double
 void HexEdge::getControlPoint(const vtkIdType cId, double ctrlp[])
 {
     if(edgeType==ARC) //theres only one controlpoint cId is ignored
-        myPoints->GetPoint(myPoints->GetNumberOfPoints()/2,ctrlp);
+        cntrlPoints->GetPoint(0,ctrlp);
 }
 
 void HexEdge::setControlPoint(const vtkIdType cId, const double cntrp[])
@@ -503,7 +525,9 @@ void HexEdge::setControlPoint(const vtkIdType cId, const double cntrp[])
     case LINE:
         break; //a line has no controlPoints
     case ARC:
-        myPoints->SetPoint(cntrlPointsIds->GetId(0),cntrp);
+        cntrlPoints->SetPoint(0,cntrp);
+        arcFrameValid=false;
+        this->Modified();
         break;
     }
 }
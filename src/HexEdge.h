@@ -29,15 +29,10 @@ License
 #include <vtkSmartPointer.h>
 #include <vtkObject.h>
 #include <QTextStream>
+#include <vector>
 
 class vtkIdList;
 class vtkPoints;
-class vtkPolyDataMapper;
-class vtkActor;
-class vtkLine;
-class vtkCellArray;
-class vtkPolyData;
-class vtkTubeFilter;
 
 
 class HexEdge : public vtkObject
@@ -67,12 +62,10 @@ public:
     bool equals(const HexEdge * other);
     bool equals(const vtkSmartPointer<vtkIdList> otherIds);
 
+    //colour the edge is drawn with, see HexEdgeRepresentation
     void setColor(double,double,double);
     void resetColor();
 
-    //radius of tube representation
-    void setRadius(double rad);
-
     //return the id of an end of the edge (id = 0 or 1)
     vtkIdType getVertIds(vtkIdType id);
 
@@ -84,15 +77,23 @@ public:
     //changes Id of a vertice. redrawEdge should probably
     //be called after this.
     void changeVertId(vtkIdType from, vtkIdType to);
-    void reduceVertId(vtkIdType vId);
+    //renumbers the vertices, the new id of vertice i is newIds[i]
+    void remapVertIds(const std::vector<vtkIdType> &newIds);
 
     double getLength();
 
     bool hasVertice(vtkIdType vId);
 
-    //redraws and edge and updates internal points
+    //updates internal points, the edge is redrawn at next render
     void redrawedge();
 
+    //number of points of the polyline the edge is drawn with, 2 for a
+    //line. An arc gets the fewest points that keep it within tol of the
+    //true arc, a fixed number if tol is 0. tol is given by the view.
+    vtkIdType getNumberOfDrawPoints(double tol);
+    //writes the getNumberOfDrawPoints(tol) points to pts from offset on
+    void getDrawPoints(double tol, vtkPoints *pts, vtkIdType offset);
+
     //sets the type and prepares internal structures
     void setType(edgeTypes newType);
     int getType();
@@ -123,27 +124,38 @@ public:
     //DATA
     vtkSmartPointer<vtkIdList> vertIds;
     vtkSmartPointer<vtkPoints> globalVertices;
-    vtkSmartPointer<vtkPolyData> data;
-    vtkSmartPointer<vtkTubeFilter> tube;
-    vtkSmartPointer<vtkPolyDataMapper> mapper;
-    vtkSmartPointer<vtkActor> actor;
+    double color[3];
     int nCells; // number of cells on edge
     double grading;
 
-    //cntrlPoints are to be printed in blockMeshDict
-    //they are ids of myPoints. Empty if type is line.
-    vtkSmartPointer<vtkIdList> cntrlPointsIds;
+    //cntrlPoints are to be printed in blockMeshDict.
+    //Kept apart from the end points in myPoints. Empty if type is line.
+    vtkSmartPointer<vtkPoints> cntrlPoints;
     vtkSmartPointer<vtkPoints> myPoints;
 private:
     //DATA
     edgeTypes edgeType;
-    vtkSmartPointer<vtkCellArray> lines;
-    int arcNpoints;
+    int arcNpoints; //points on an arc if no tolerance is given
 
+    //the circle of the arc and the end points it was computed for,
+    //see updateArcFrame
+    double arcCenter[3];
+    double arcRadius;
+    double arcEnds[2][3];
+    bool arcFrameValid;
 
     //FUNCTIONS
-    void drawArc(double c[3]);
     void drawLine();
+    //computes the circle through the end points and arcp
+    void setArcFrame(const double arcp[3]);
+    //recomputes the circle if the end points or the control
+    //point has changed since the last time
+    void updateArcFrame();
+    //number of points needed on the arc for the tolerance
+    int calcArcNpoints(double tol);
+    //point t on the chord p0-p1 projected on the circle (c,R)
+    static void pointOnArc(const double t, const double c[3], const double R,
+                           const double p0[3], const double p1[3], double pt[3]);
     //calcs f=|r_n| - R, used by calcArcControlPointFromCenter
     //please see images/HexEdge_calcArcPoint_prescribed_radius*
     double secF(const double R,const double pac[3], const double xn);
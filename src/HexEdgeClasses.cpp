@@ -0,0 +1,158 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexEdgeClasses.h"
+#include "HexBlock.h"
+#include "HexEdge.h"
+#include "HexCollection.h"
+
+#include <vtkObjectFactory.h>
+#include <algorithm>
+
+vtkStandardNewMacro(HexEdgeClasses);
+
+HexEdgeClasses::HexEdgeClasses()
+{
+    isValid = false;
+}
+
+HexEdgeClasses::~HexEdgeClasses()
+{
+
+}
+
+void HexEdgeClasses::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "edges: " << slots.size()
+       << ", valid: " << isValid << std::endl;
+}
+
+void HexEdgeClasses::setBlocks(HexCollection *blocks)
+{
+    hexBlocks = blocks;
+    invalidate();
+}
+
+void HexEdgeClasses::addBlock(HexBlock *hb)
+{
+    //no use updating, everything is redone at the next query
+    if(!isValid)
+        return;
+    //edges 0-3, 4-7 and 8-11 are parallel
+    for(vtkIdType dir=0;dir<3;dir++)
+    {
+        HexEdge *first = HexEdge::SafeDownCast(
+                    hb->localEdges->GetItemAsObject(4*dir));
+        for(vtkIdType i=1;i<4;i++)
+            join(first,HexEdge::SafeDownCast(
+                     hb->localEdges->GetItemAsObject(4*dir+i)));
+    }
+}
+
+void HexEdgeClasses::invalidate()
+{
+    isValid = false;
+}
+
+const std::vector<HexEdge *> & HexEdgeClasses::parallelEdges(HexEdge *e)
+{
+    if(!isValid)
+        rebuild();
+    std::map<HexEdge *,vtkIdType>::iterator it = slots.find(e);
+    if(it == slots.end())
+    {
+        //not in any block, it's alone in its class
+        single.assign(1,e);
+        return single;
+    }
+    return members[findRoot(it->second)];
+}
+
+bool HexEdgeClasses::isParallel(HexEdge *a, HexEdge *b)
+{
+    if(a == b)
+        return true;
+    if(!isValid)
+        rebuild();
+    std::map<HexEdge *,vtkIdType>::iterator ia = slots.find(a);
+    std::map<HexEdge *,vtkIdType>::iterator ib = slots.find(b);
+    if(ia == slots.end() || ib == slots.end())
+        return false;
+    return findRoot(ia->second) == findRoot(ib->second);
+}
+
+void HexEdgeClasses::rebuild()
+{
+    slots.clear();
+    parent.clear();
+    members.clear();
+    isValid = true;
+    if(hexBlocks == NULL)
+        return;
+    for(vtkIdType i=0;i<hexBlocks->GetNumberOfItems();i++)
+        addBlock(HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i)));
+}
+
+vtkIdType HexEdgeClasses::slotOf(HexEdge *e)
+{
+    std::map<HexEdge *,vtkIdType>::iterator it = slots.find(e);
+    if(it != slots.end())
+        return it->second;
+    vtkIdType s = parent.size();
+    slots.insert(std::make_pair(e,s));
+    parent.push_back(s);
+    members.push_back(std::vector<HexEdge *>(1,e));
+    return s;
+}
+
+vtkIdType HexEdgeClasses::findRoot(vtkIdType s)
+{
+    vtkIdType root = s;
+    while(parent[root] != root)
+        root = parent[root];
+    //path compression
+    while(parent[s] != root)
+    {
+        vtkIdType next = parent[s];
+        parent[s] = root;
+        s = next;
+    }
+    return root;
+}
+
+void HexEdgeClasses::join(HexEdge *a, HexEdge *b)
+{
+    vtkIdType ra = findRoot(slotOf(a));
+    vtkIdType rb = findRoot(slotOf(b));
+    if(ra == rb)
+        return;
+    //the larger class becomes the root, so an edge
+    //is moved O(log n) times at most
+    if(members[ra].size() < members[rb].size())
+        std::swap(ra,rb);
+    parent[rb] = ra;
+    members[ra].insert(members[ra].end(),members[rb].begin(),members[rb].end());
+    std::vector<HexEdge *>().swap(members[rb]);
+}
@@ -0,0 +1,95 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    The classes of parallel edges, i.e. the edges that blockMesh forces
+    to have the same number of cells. In a block the edges 0-3, 4-7 and
+    8-11 are parallel, and blocks sharing an edge join their classes.
+    The classes are kept in a union-find (disjoint set) structure that
+    is updated when blocks are added. Union-find can't split a class, so
+    when blocks or edges are removed the structure is marked invalid and
+    rebuilt from all blocks at the next query.
+*/
+
+#ifndef HEXEDGECLASSES_H
+#define HEXEDGECLASSES_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+#include <map>
+
+class HexBlock;
+class HexEdge;
+class HexCollection;
+
+class HexEdgeClasses : public vtkObject
+{
+    vtkTypeMacro(HexEdgeClasses,vtkObject)
+
+protected:
+    HexEdgeClasses();
+    ~HexEdgeClasses();
+    HexEdgeClasses(const HexEdgeClasses&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexEdgeClasses&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexEdgeClasses *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the blocks the classes are built from, marks the classes invalid
+    void setBlocks(HexCollection *blocks);
+
+    //joins the classes of the parallel edges in hb
+    void addBlock(HexBlock *hb);
+
+    //blocks have been removed or their edges changed, rebuild
+    //before the next query
+    void invalidate();
+
+    //all edges in the same class as e, e included
+    const std::vector<HexEdge *> & parallelEdges(HexEdge *e);
+
+    //true if a and b are in the same class
+    bool isParallel(HexEdge *a, HexEdge *b);
+
+private:
+    void rebuild();
+    vtkIdType slotOf(HexEdge *e);
+    vtkIdType findRoot(vtkIdType s);
+    void join(HexEdge *a, HexEdge *b);
+
+    //DATA
+    vtkSmartPointer<HexCollection> hexBlocks;
+    bool isValid;
+    std::map<HexEdge *,vtkIdType> slots;
+    std::vector<vtkIdType> parent;
+    //the edges of a class, only kept at the root
+    std::vector<std::vector<HexEdge *> > members;
+    std::vector<HexEdge *> single;
+};
+
+#endif // HEXEDGECLASSES_H
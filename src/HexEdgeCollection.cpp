@@ -0,0 +1,95 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexEdgeCollection.h"
+#include "HexEdge.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+
+vtkStandardNewMacro(HexEdgeCollection);
+
+HexEdgeCollection::HexEdgeCollection()
+{
+
+}
+
+HexEdgeCollection::~HexEdgeCollection()
+{
+
+}
+
+void HexEdgeCollection::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "edges: " << this->GetNumberOfItems()
+       << ", indexed: " << index.size() << std::endl;
+}
+
+void HexEdgeCollection::itemAdded(vtkObject *a)
+{
+    HexEdge *e = HexEdge::SafeDownCast(a);
+    if(e != NULL)
+        addToIndex(e);
+}
+
+void HexEdgeCollection::itemRemoved(vtkObject *a)
+{
+    index.remove(a);
+}
+
+void HexEdgeCollection::addToIndex(HexEdge *e)
+{
+    index.add(e,e->vertIds);
+}
+
+void HexEdgeCollection::removeFromIndex(HexEdge *e)
+{
+    index.remove(e);
+}
+
+HexEdge * HexEdgeCollection::findEdge(vtkIdType a, vtkIdType b)
+{
+    vtkIdType ids[2] = {a,b};
+    return static_cast<HexEdge *>(index.find(ids,2));
+}
+
+vtkIdType HexEdgeCollection::findEdgeId(vtkIdType a, vtkIdType b)
+{
+    HexEdge *e = findEdge(a,b);
+    if(e == NULL)
+        return vtkIdType(-1);
+    return findItem(e);
+}
+
+void HexEdgeCollection::rebuildIndex()
+{
+    index.clear();
+    for(vtkIdType i=0;i<this->GetNumberOfItems();i++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(this->GetItemAsObject(i));
+        if(e != NULL)
+            addToIndex(e);
+    }
+}
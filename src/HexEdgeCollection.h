@@ -0,0 +1,86 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    The global list of edges. It works as a HexCollection but also keeps
+    an index from the (unordered) pair of vertice ids to the edge, so an
+    edge can be found without comparing against every edge in the model.
+    The index (see HexVertIdsIndex) follows every change of the list,
+    also through a HexCollection pointer. Edges whose vertice ids are
+    changed while in the list must be put in the index again, see
+    addToIndex.
+*/
+
+#ifndef HEXEDGECOLLECTION_H
+#define HEXEDGECOLLECTION_H
+
+#include "HexCollection.h"
+#include "HexVertIdsIndex.h"
+
+class HexEdge;
+class vtkIdList;
+
+class HexEdgeCollection : public HexCollection
+{
+    vtkTypeMacro(HexEdgeCollection,HexCollection)
+
+protected:
+    HexEdgeCollection();
+    ~HexEdgeCollection();
+    HexEdgeCollection(const HexEdgeCollection&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexEdgeCollection&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexEdgeCollection *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //returns the edge between vertices a and b, in any order,
+    //or NULL if there is no such edge.
+    HexEdge * findEdge(vtkIdType a, vtkIdType b);
+
+    //as above but returns the position in the list, or -1.
+    vtkIdType findEdgeId(vtkIdType a, vtkIdType b);
+
+    //clears and refills the index. Has to be called when the
+    //vertice ids of the edges in the list have been changed.
+    void rebuildIndex();
+
+    //for changing the ids of a few edges: put them in the index
+    //again after the change.
+    void removeFromIndex(HexEdge *e);
+    void addToIndex(HexEdge *e);
+
+protected:
+    //keep the index in step with the list
+    void itemAdded(vtkObject *a);
+    void itemRemoved(vtkObject *a);
+
+private:
+    //DATA
+    HexVertIdsIndex index;
+};
+
+#endif // HEXEDGECOLLECTION_H
@@ -0,0 +1,231 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexEdgeRepresentation.h"
+#include "HexEdge.h"
+#include "HexEdgeCollection.h"
+#include "HexDirtyItems.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkIntArray.h>
+#include <vtkCellData.h>
+#include <vtkPolyData.h>
+#include <vtkTubeFilter.h>
+#include <vtkLookupTable.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkActor.h>
+#include <vtkDataArray.h>
+#include <vtkCellLocator.h>
+
+vtkStandardNewMacro(HexEdgeRepresentation);
+
+HexEdgeRepresentation::HexEdgeRepresentation()
+{
+    arcTolerance = 0.0;
+    dirty = vtkSmartPointer<HexDirtyItems>::New();
+    points = vtkSmartPointer<vtkPoints>::New();
+    lines = vtkSmartPointer<vtkCellArray>::New();
+    edgeIds = vtkSmartPointer<vtkIntArray>::New();
+    edgeIds->SetName("edgeIds");
+
+    data = vtkSmartPointer<vtkPolyData>::New();
+    data->SetPoints(points);
+    data->SetLines(lines);
+    data->GetCellData()->SetScalars(edgeIds);
+
+    //one filter for all edges, cell data goes on to the tubes
+    tubes = vtkSmartPointer<vtkTubeFilter>::New();
+    tubes->SetNumberOfSides(24);
+    tubes->SetRadius(0.05);
+#if VTK_MAJOR_VERSION >= 6
+    tubes->SetInputData(data);
+#else
+    tubes->SetInput(data);
+#endif
+
+    colors = vtkSmartPointer<vtkLookupTable>::New();
+
+    mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    mapper->SetInputConnection(tubes->GetOutputPort());
+    mapper->SetLookupTable(colors);
+    mapper->SetScalarModeToUseCellData();
+    mapper->UseLookupTableScalarRangeOn();
+
+    actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetMapper(mapper);
+
+    locator = vtkSmartPointer<vtkCellLocator>::New();
+}
+
+HexEdgeRepresentation::~HexEdgeRepresentation()
+{
+
+}
+
+void HexEdgeRepresentation::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "edges: " << offsets.size()
+       << ", points: " << points->GetNumberOfPoints() << std::endl;
+}
+
+void HexEdgeRepresentation::setEdges(HexEdgeCollection *edgeList)
+{
+    edges = edgeList;
+    this->Modified();
+}
+
+void HexEdgeRepresentation::setRadius(double rad)
+{
+    tubes->SetRadius(rad);
+}
+
+void HexEdgeRepresentation::setArcTolerance(double tol)
+{
+    if(tol == arcTolerance)
+        return;
+    arcTolerance = tol;
+    if(edges == NULL)
+        return;
+    //lines look the same for any tolerance
+    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
+    {
+        if(HexEdge::SafeDownCast(edges->GetItemAsObject(i))->getType() == HexEdge::ARC)
+        {
+            this->Modified();
+            return;
+        }
+    }
+}
+
+void HexEdgeRepresentation::update()
+{
+    if(edges == NULL)
+        return;
+
+    if(edges->GetMTime() > buildTime || this->GetMTime() > buildTime)
+    {
+        rebuild();
+        return;
+    }
+
+    //only the edges that are marked as modified, e.g. by
+    //redrawedge when their vertices have moved
+    std::vector<vtkIdType> ids;
+    dirty->takeDirty(ids);
+    if(ids.empty())
+        return;
+    for(size_t i=0;i<ids.size();i++)
+    {
+        if(!updateEdge(ids[i]))
+        {
+            rebuild();
+            return;
+        }
+    }
+    points->Modified();
+    colors->Modified();
+    data->Modified();
+}
+
+void HexEdgeRepresentation::rebuild()
+{
+    vtkIdType numEdges = edges->GetNumberOfItems();
+    offsets.resize(numEdges);
+
+    //count first so everything is allocated once
+    vtkIdType numPoints = 0;
+    for(vtkIdType i=0;i<numEdges;i++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
+        offsets[i] = numPoints;
+        numPoints += e->getNumberOfDrawPoints(arcTolerance);
+    }
+    dirty->watch(edges);
+
+    if(numEdges > 0)
+    {
+        colors->SetNumberOfTableValues(numEdges);
+        //one table value per edge id
+        colors->SetTableRange(-0.5,numEdges-0.5);
+    }
+    points->SetNumberOfPoints(numPoints);
+    edgeIds->SetNumberOfValues(numEdges);
+    //connectivity is (n, id_0 ... id_n-1) for each polyline
+    vtkIdType *conn = lines->WritePointer(numEdges,numEdges+numPoints);
+    for(vtkIdType i=0;i<numEdges;i++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
+        vtkIdType n = e->getNumberOfDrawPoints(arcTolerance);
+        *conn++ = n;
+        for(vtkIdType j=0;j<n;j++)
+            *conn++ = offsets[i]+j;
+        edgeIds->SetValue(i,i);
+        updateEdge(i);
+    }
+
+    lines->Modified();
+    edgeIds->Modified();
+    points->Modified();
+    colors->Modified();
+    data->Modified();
+    buildTime.Modified();
+}
+
+bool HexEdgeRepresentation::updateEdge(vtkIdType i)
+{
+    HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
+    vtkIdType n = e->getNumberOfDrawPoints(arcTolerance);
+    vtkIdType end = (i+1 < vtkIdType(offsets.size())) ? offsets[i+1] : points->GetNumberOfPoints();
+    if(end - offsets[i] != n)
+        return false;
+
+    e->getDrawPoints(arcTolerance,points,offsets[i]);
+    colors->SetTableValue(i,e->color[0],e->color[1],e->color[2]);
+    return true;
+}
+
+vtkIdType HexEdgeRepresentation::getEdgeId(vtkIdType cellId)
+{
+    //every edge is several strips of the tube
+    vtkDataArray *ids = tubes->GetOutput()->GetCellData()->GetArray("edgeIds");
+    if(ids == NULL || cellId < 0 || cellId >= ids->GetNumberOfTuples())
+        return -1;
+    return vtkIdType(ids->GetTuple1(cellId));
+}
+
+vtkCellLocator * HexEdgeRepresentation::getLocator()
+{
+    tubes->Update();
+    vtkDataSet *out = tubes->GetOutput();
+    if(locator->GetDataSet() != out || out->GetMTime() > locatorTime)
+    {
+        locator->SetDataSet(out);
+        locator->BuildLocator();
+        locatorTime.Modified();
+    }
+    return locator;
+}
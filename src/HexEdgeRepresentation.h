@@ -0,0 +1,127 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Draws all edges in the model with a single polydata, mapper and
+    actor instead of one of each per edge. Each edge is one polyline
+    cell and its position in the edge list is stored as cell scalar,
+    the colour of the edges are looked up from that in a table.
+    The lines are drawn as tubes by one tube filter over the whole
+    polydata, which passes the edge ids on to the tube cells.
+    update(), called by HexView before each render, gets the points
+    of the edges modified since last time (see HexDirtyItems), arcs
+    with the tolerance set by the view. Everything is rebuilt when edges
+    are added or removed, the tolerance changes or an arc gets more or
+    fewer points.
+*/
+
+#ifndef HEXEDGEREPRESENTATION_H
+#define HEXEDGEREPRESENTATION_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+
+class HexEdge;
+class HexEdgeCollection;
+class HexDirtyItems;
+class vtkPoints;
+class vtkCellArray;
+class vtkIntArray;
+class vtkPolyData;
+class vtkTubeFilter;
+class vtkLookupTable;
+class vtkPolyDataMapper;
+class vtkActor;
+class vtkCellLocator;
+
+class HexEdgeRepresentation : public vtkObject
+{
+    vtkTypeMacro(HexEdgeRepresentation,vtkObject)
+
+protected:
+    HexEdgeRepresentation();
+    ~HexEdgeRepresentation();
+    HexEdgeRepresentation(const HexEdgeRepresentation&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexEdgeRepresentation&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexEdgeRepresentation *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the edges to draw
+    void setEdges(HexEdgeCollection *edgeList);
+
+    //radius of the tubes in model units
+    void setRadius(double rad);
+
+    //largest distance between a drawn arc and the true arc, see
+    //HexEdge::getNumberOfDrawPoints. The arcs are drawn again if it changes.
+    void setArcTolerance(double tol);
+
+    //brings the polydata and colours up to date with the edges,
+    //only what has changed since the last call is redone.
+    void update();
+
+    //the position in the edge list of the edge drawn by cell cellId
+    //of the rendered data, -1 if there is no such cell.
+    vtkIdType getEdgeId(vtkIdType cellId);
+
+    //locator of the rendered data for the picker, rebuilt
+    //if the data has changed since the last pick
+    vtkCellLocator * getLocator();
+
+    //DATA
+    vtkSmartPointer<vtkActor> actor;
+
+private:
+    //FUNCTIONS
+    //recreates points, cells and colours of all edges
+    void rebuild();
+    //copies the points and colour of edge i, false if the
+    //number of points of the edge has changed.
+    bool updateEdge(vtkIdType i);
+
+    //DATA
+    vtkSmartPointer<HexEdgeCollection> edges;
+    vtkSmartPointer<HexDirtyItems> dirty;
+    vtkSmartPointer<vtkPoints> points;
+    vtkSmartPointer<vtkCellArray> lines;
+    vtkSmartPointer<vtkIntArray> edgeIds;
+    vtkSmartPointer<vtkPolyData> data;
+    vtkSmartPointer<vtkTubeFilter> tubes;
+    vtkSmartPointer<vtkLookupTable> colors;
+    vtkSmartPointer<vtkPolyDataMapper> mapper;
+
+    //first point of each edge in points
+    std::vector<vtkIdType> offsets;
+    vtkTimeStamp buildTime;
+    double arcTolerance;
+    vtkSmartPointer<vtkCellLocator> locator;
+    vtkTimeStamp locatorTime;
+};
+
+#endif // HEXEDGEREPRESENTATION_H
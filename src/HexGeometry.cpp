@@ -0,0 +1,175 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexGeometry.h"
+#include "HexSTLReader.h"
+#include "HexSurfaceLocator.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkPolyData.h>
+#include <vtkTransform.h>
+#include <vtkFeatureEdges.h>
+
+#include <QFileInfo>
+
+vtkStandardNewMacro(HexGeometry);
+
+HexGeometry::HexGeometry()
+{
+    reader = vtkSmartPointer<HexSTLReader>::New();
+    transform = vtkSmartPointer<vtkTransform>::New();
+    locator = vtkSmartPointer<HexSurfaceLocator>::New();
+    scale = 1.0;
+    visible = true;
+
+    //feature edges are found between cells sharing point ids, the
+    //points of the surface are merged only when features are extracted
+    merged = vtkSmartPointer<vtkPolyData>::New();
+    featureEdges = vtkSmartPointer<vtkFeatureEdges>::New();
+    featureEdges->BoundaryEdgesOn();
+    featureEdges->FeatureEdgesOn();
+    featureEdges->NonManifoldEdgesOn();
+    featureEdges->ManifoldEdgesOff();
+    featureEdges->ColoringOff();
+    featureEdges->SetFeatureAngle(30.0);
+    featureLocator = vtkSmartPointer<HexSurfaceLocator>::New();
+    featureTime = 0;
+}
+
+HexGeometry::~HexGeometry()
+{
+
+}
+
+void HexGeometry::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "geometry: " << name
+       << ", scale: " << scale
+       << ", feature angle: " << getFeatureAngle()
+       << ", visible: " << getVisibility() << std::endl;
+}
+
+bool HexGeometry::read(const char *fileName)
+{
+    name = QFileInfo(fileName).completeBaseName().toAscii().data();
+    reader->SetFileName(fileName);
+    reader->Update();
+    if(reader->GetOutput()->GetNumberOfCells() == 0)
+        return false;
+
+    //built in the background while the geometry is drawn
+    locator->setSurface(reader->GetOutput());
+    if(reader->GetMerging())
+        featureEdges->SetInputConnection(reader->GetOutputPort());
+    else
+    {
+        merged = vtkSmartPointer<vtkPolyData>::New();
+#if VTK_MAJOR_VERSION >= 6
+        featureEdges->SetInputData(merged);
+#else
+        featureEdges->SetInput(merged);
+#endif
+    }
+    featureLocator = vtkSmartPointer<HexSurfaceLocator>::New();
+    featureTime = 0;
+    transformChanged();
+    return true;
+}
+
+void HexGeometry::setScale(double s)
+{
+    scale = s;
+    transform->Identity();
+    transform->Scale(s,s,s);
+    transformChanged();
+}
+
+double HexGeometry::getScale()
+{
+    return scale;
+}
+
+void HexGeometry::transformChanged()
+{
+    locator->setTransform(transform->GetMatrix());
+    featureLocator->setTransform(transform->GetMatrix());
+    this->Modified();
+}
+
+void HexGeometry::setVisibility(bool mode)
+{
+    if(visible == mode)
+        return;
+    visible = mode;
+    this->Modified();
+}
+
+bool HexGeometry::getVisibility()
+{
+    return visible;
+}
+
+void HexGeometry::setFeatureAngle(double angle)
+{
+    //featureEdges is only modified if the angle changes
+    featureEdges->SetFeatureAngle(angle);
+}
+
+double HexGeometry::getFeatureAngle()
+{
+    return featureEdges->GetFeatureAngle();
+}
+
+HexSurfaceLocator * HexGeometry::getFeatureLocator()
+{
+    if(featureTime == 0 || featureEdges->GetMTime() > featureTime)
+        extractFeatures();
+    return featureLocator;
+}
+
+void HexGeometry::extractFeatures()
+{
+    if(!locator->hasSurface())
+        return;
+    if(!reader->GetMerging() && merged->GetNumberOfPoints() == 0)
+        HexSTLReader::MergePoints(reader->GetOutput(),merged);
+    featureEdges->Update();
+    featureTime = featureEdges->GetMTime();
+
+    //built in the background, the first query waits for it
+    featureLocator->setSurface(featureEdges->GetOutput());
+    featureLocator->setTransform(transform->GetMatrix());
+    this->Modified();
+}
+
+bool HexGeometry::hasFeatures()
+{
+    return featureTime > 0;
+}
+
+vtkAlgorithmOutput * HexGeometry::getFeatureOutputPort()
+{
+    return featureEdges->GetOutputPort();
+}
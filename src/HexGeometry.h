@@ -0,0 +1,114 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    One geometry (STL surface) of the model. It has its own reader,
+    transform, visibility and surface locator, so several
+    surfaces (inlet, outlet, walls, ...) can be loaded at once and
+    scaled or moved one by one. The geometries are kept in
+    HexBlocker::geometries and drawn by HexGeometryRepresentation.
+    The feature curves of the surface (sharp edges by feature angle,
+    open boundaries and non-manifold edges) are extracted on first
+    use and have a locator of their own, for snapping to e.g. a
+    trailing edge instead of the closest point on the surface.
+*/
+
+#ifndef HEXGEOMETRY_H
+#define HEXGEOMETRY_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <string>
+
+class HexSTLReader;
+class HexSurfaceLocator;
+class vtkTransform;
+class vtkAlgorithmOutput;
+class vtkFeatureEdges;
+class vtkPolyData;
+
+class HexGeometry : public vtkObject
+{
+    vtkTypeMacro(HexGeometry,vtkObject)
+
+protected:
+    HexGeometry();
+    ~HexGeometry();
+    HexGeometry(const HexGeometry&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexGeometry&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexGeometry *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //reads an STL file, the name is set to the file name
+    //without directory and extension. False if it couldn't be read.
+    bool read(const char *fileName);
+
+    //scale about the origin, replaces the transform
+    void setScale(double s);
+    double getScale();
+
+    //call after changing transform, updates the locators
+    void transformChanged();
+
+    void setVisibility(bool mode);
+    bool getVisibility();
+
+    //edges between triangles whose normals differ by more than angle
+    //(degrees) are feature edges, default 30
+    void setFeatureAngle(double angle);
+    double getFeatureAngle();
+
+    //locator of the feature curves, extracted if the surface or
+    //the feature angle has changed since the last call
+    HexSurfaceLocator * getFeatureLocator();
+
+    //true once the feature curves have been extracted, they are
+    //then drawn from getFeatureOutputPort
+    bool hasFeatures();
+    vtkAlgorithmOutput * getFeatureOutputPort();
+
+    //DATA
+    std::string name;
+    vtkSmartPointer<HexSTLReader> reader;
+    vtkSmartPointer<vtkTransform> transform; //surface to model coordinates
+    vtkSmartPointer<HexSurfaceLocator> locator; //closest points in model coordinates
+
+private:
+    //FUNCTIONS
+    void extractFeatures();
+
+    //DATA
+    double scale;
+    bool visible;
+    vtkSmartPointer<vtkPolyData> merged; //merged points if reader doesn't merge
+    vtkSmartPointer<vtkFeatureEdges> featureEdges;
+    vtkSmartPointer<HexSurfaceLocator> featureLocator;
+    unsigned long featureTime; //MTime of featureEdges at the last extraction
+};
+
+#endif // HEXGEOMETRY_H
@@ -0,0 +1,148 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexGeometryRepresentation.h"
+#include "HexGeometry.h"
+#include "HexSTLReader.h"
+#include "HexCollection.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkActor.h>
+#include <vtkAssembly.h>
+#include <vtkTransform.h>
+
+vtkStandardNewMacro(HexGeometryRepresentation);
+
+HexGeometryRepresentation::HexGeometryRepresentation()
+{
+    actor = vtkSmartPointer<vtkAssembly>::New();
+}
+
+HexGeometryRepresentation::~HexGeometryRepresentation()
+{
+
+}
+
+void HexGeometryRepresentation::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "geometries: " << parts.size() << std::endl;
+}
+
+void HexGeometryRepresentation::setGeometries(HexCollection *geoList)
+{
+    geometries = geoList;
+    this->Modified();
+}
+
+void HexGeometryRepresentation::update()
+{
+    if(geometries == NULL)
+        return;
+
+    if(geometries->GetMTime() > buildTime || this->GetMTime() > buildTime)
+    {
+        rebuild();
+    }
+    else
+    {
+        for(size_t i=0;i<parts.size();i++)
+        {
+            if(parts[i].geo->GetMTime() > buildTime)
+                updateParts(parts[i]);
+        }
+    }
+    buildTime.Modified();
+}
+
+void HexGeometryRepresentation::rebuild()
+{
+    //geometries are only added and removed, so keep the parts
+    //of the ones still there
+    std::vector<Parts> oldParts;
+    oldParts.swap(parts);
+    for(vtkIdType i=0;i<geometries->GetNumberOfItems();i++)
+    {
+        HexGeometry *geo = HexGeometry::SafeDownCast(geometries->GetItemAsObject(i));
+        size_t k=0;
+        while(k < oldParts.size() && oldParts[k].geo != geo)
+            k++;
+        if(k < oldParts.size())
+        {
+            parts.push_back(oldParts[k]);
+            oldParts.erase(oldParts.begin()+k);
+        }
+        else
+        {
+            parts.push_back(newParts(geo));
+            actor->AddPart(parts.back().surface);
+            actor->AddPart(parts.back().features);
+        }
+        updateParts(parts.back());
+    }
+
+    for(size_t k=0;k<oldParts.size();k++)
+    {
+        actor->RemovePart(oldParts[k].surface);
+        actor->RemovePart(oldParts[k].features);
+    }
+}
+
+HexGeometryRepresentation::Parts HexGeometryRepresentation::newParts(HexGeometry *geo)
+{
+    Parts p;
+    p.geo = geo;
+
+    vtkSmartPointer<vtkPolyDataMapper> mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    mapper->SetInputConnection(geo->reader->GetOutputPort());
+    //the region ids are not colours
+    mapper->ScalarVisibilityOff();
+    p.surface = vtkSmartPointer<vtkActor>::New();
+    p.surface->GetProperty()->SetOpacity(0.5);
+    p.surface->SetMapper(mapper);
+    p.surface->SetUserTransform(geo->transform);
+
+    vtkSmartPointer<vtkPolyDataMapper> featureMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    featureMapper->SetInputConnection(geo->getFeatureOutputPort());
+    featureMapper->ScalarVisibilityOff();
+    p.features = vtkSmartPointer<vtkActor>::New();
+    p.features->GetProperty()->SetColor(1.0,0.2,0.2);
+    p.features->GetProperty()->SetLineWidth(2);
+    p.features->SetMapper(featureMapper);
+    p.features->SetUserTransform(geo->transform);
+    return p;
+}
+
+void HexGeometryRepresentation::updateParts(Parts &p)
+{
+    bool visible = p.geo->getVisibility();
+    p.surface->SetVisibility(visible);
+    //shown once they have been extracted
+    p.features->SetVisibility(visible && p.geo->hasFeatures());
+    //the transform may have changed
+    p.surface->Modified();
+    p.features->Modified();
+}
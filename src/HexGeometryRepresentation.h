@@ -0,0 +1,93 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Draws the geometries (STL surfaces) of the model and their feature
+    curves. Each geometry gets a surface actor and a feature actor, both
+    parts of one assembly and both following the transform of the
+    geometry. The parts are made when a geometry is added and dropped
+    when it is removed; the feature curves are shown once they have been
+    extracted, see HexGeometry.
+*/
+
+#ifndef HEXGEOMETRYREPRESENTATION_H
+#define HEXGEOMETRYREPRESENTATION_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+
+class HexGeometry;
+class HexCollection;
+class vtkActor;
+class vtkAssembly;
+
+class HexGeometryRepresentation : public vtkObject
+{
+    vtkTypeMacro(HexGeometryRepresentation,vtkObject)
+
+protected:
+    HexGeometryRepresentation();
+    ~HexGeometryRepresentation();
+    HexGeometryRepresentation(const HexGeometryRepresentation&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexGeometryRepresentation&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexGeometryRepresentation *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the geometries to draw
+    void setGeometries(HexCollection *geoList);
+
+    //adds and removes parts for added and removed geometries and
+    //updates the visibility and transform of the changed ones.
+    void update();
+
+    //DATA
+    vtkSmartPointer<vtkAssembly> actor;
+
+private:
+    //the actors of one geometry
+    struct Parts
+    {
+        vtkSmartPointer<HexGeometry> geo;
+        vtkSmartPointer<vtkActor> surface;
+        vtkSmartPointer<vtkActor> features;
+    };
+
+    //FUNCTIONS
+    //parts for the geometries in the list, in the same order
+    void rebuild();
+    Parts newParts(HexGeometry *geo);
+    void updateParts(Parts &p);
+
+    //DATA
+    vtkSmartPointer<HexCollection> geometries;
+    std::vector<Parts> parts;
+    vtkTimeStamp buildTime;
+};
+
+#endif // HEXGEOMETRYREPRESENTATION_H
@@ -0,0 +1,221 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexIncidence.h"
+#include "HexBlock.h"
+#include "HexEdge.h"
+#include "HexPatch.h"
+#include "HexCollection.h"
+#include "HexEdgeCollection.h"
+#include "HexPatchCollection.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+
+#include <algorithm>
+
+vtkStandardNewMacro(HexIncidence);
+
+//the lists are short (the degree of a vertice or edge),
+//so a linear search is fine.
+template <class T>
+static void insertUnique(std::vector<T *> &list, T *item)
+{
+    if(std::find(list.begin(),list.end(),item) == list.end())
+        list.push_back(item);
+}
+
+template <class T>
+static void eraseItem(std::vector<T *> &list, T *item)
+{
+    typename std::vector<T *>::iterator it =
+            std::find(list.begin(),list.end(),item);
+    if(it != list.end())
+        list.erase(it);
+}
+
+template <class T>
+static std::vector<T> & grow(std::vector<T> &table, vtkIdType vId)
+{
+    if(vId >= vtkIdType(table.size()))
+        table.resize(vId+1);
+    return table[vId];
+}
+
+HexIncidence::HexIncidence()
+{
+
+}
+
+HexIncidence::~HexIncidence()
+{
+
+}
+
+void HexIncidence::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "vertices: " << vertBlocks.size()
+       << ", edges with blocks: " << edgeBlockMap.size() << std::endl;
+}
+
+void HexIncidence::build(HexCollection *blocks, HexEdgeCollection *edges,
+                         HexPatchCollection *patches)
+{
+    clear();
+    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
+        addEdge(HexEdge::SafeDownCast(edges->GetItemAsObject(i)));
+    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
+        addPatch(HexPatch::SafeDownCast(patches->GetItemAsObject(i)));
+    for(vtkIdType i=0;i<blocks->GetNumberOfItems();i++)
+        addBlock(HexBlock::SafeDownCast(blocks->GetItemAsObject(i)));
+}
+
+void HexIncidence::clear()
+{
+    vertBlocks.clear();
+    vertEdges.clear();
+    vertPatches.clear();
+    edgeBlockMap.clear();
+}
+
+//moves row i to row newIds[i], the rows only move down
+template <class T>
+static void remapRows(std::vector<T> &table, const std::vector<vtkIdType> &newIds)
+{
+    vtkIdType n = 0;
+    for(vtkIdType i=0;i<vtkIdType(table.size());i++)
+    {
+        if(i >= vtkIdType(newIds.size()) || newIds[i] < 0)
+            continue;
+        if(newIds[i] != i)
+            table[newIds[i]].swap(table[i]);
+        n = newIds[i]+1;
+    }
+    table.resize(n);
+}
+
+void HexIncidence::remapVertices(const std::vector<vtkIdType> &newIds)
+{
+    remapRows(vertBlocks,newIds);
+    remapRows(vertEdges,newIds);
+    remapRows(vertPatches,newIds);
+}
+
+void HexIncidence::addBlock(HexBlock *hb)
+{
+    for(vtkIdType i=0;i<hb->vertIds->GetNumberOfIds();i++)
+        insertUnique(grow(vertBlocks,hb->vertIds->GetId(i)),hb);
+    for(vtkIdType i=0;i<hb->localEdges->GetNumberOfItems();i++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(hb->localEdges->GetItemAsObject(i));
+        insertUnique(edgeBlockMap[e],hb);
+    }
+}
+
+void HexIncidence::removeBlock(HexBlock *hb)
+{
+    for(vtkIdType i=0;i<hb->vertIds->GetNumberOfIds();i++)
+    {
+        vtkIdType vId = hb->vertIds->GetId(i);
+        if(vId < vtkIdType(vertBlocks.size()))
+            eraseItem(vertBlocks[vId],hb);
+    }
+    for(vtkIdType i=0;i<hb->localEdges->GetNumberOfItems();i++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(hb->localEdges->GetItemAsObject(i));
+        std::map<HexEdge *,BlockList>::iterator it = edgeBlockMap.find(e);
+        if(it == edgeBlockMap.end())
+            continue;
+        eraseItem(it->second,hb);
+        if(it->second.empty())
+            edgeBlockMap.erase(it);
+    }
+}
+
+void HexIncidence::addEdge(HexEdge *e)
+{
+    for(vtkIdType i=0;i<e->vertIds->GetNumberOfIds();i++)
+        insertUnique(grow(vertEdges,e->vertIds->GetId(i)),e);
+}
+
+void HexIncidence::removeEdge(HexEdge *e)
+{
+    for(vtkIdType i=0;i<e->vertIds->GetNumberOfIds();i++)
+    {
+        vtkIdType vId = e->vertIds->GetId(i);
+        if(vId < vtkIdType(vertEdges.size()))
+            eraseItem(vertEdges[vId],e);
+    }
+    edgeBlockMap.erase(e);
+}
+
+void HexIncidence::addPatch(HexPatch *p)
+{
+    for(vtkIdType i=0;i<p->vertIds->GetNumberOfIds();i++)
+        insertUnique(grow(vertPatches,p->vertIds->GetId(i)),p);
+}
+
+void HexIncidence::removePatch(HexPatch *p)
+{
+    for(vtkIdType i=0;i<p->vertIds->GetNumberOfIds();i++)
+    {
+        vtkIdType vId = p->vertIds->GetId(i);
+        if(vId < vtkIdType(vertPatches.size()))
+            eraseItem(vertPatches[vId],p);
+    }
+}
+
+const HexIncidence::BlockList & HexIncidence::verticeBlocks(vtkIdType vId)
+{
+    static const BlockList none;
+    if(vId < 0 || vId >= vtkIdType(vertBlocks.size()))
+        return none;
+    return vertBlocks[vId];
+}
+
+const HexIncidence::EdgeList & HexIncidence::verticeEdges(vtkIdType vId)
+{
+    static const EdgeList none;
+    if(vId < 0 || vId >= vtkIdType(vertEdges.size()))
+        return none;
+    return vertEdges[vId];
+}
+
+const HexIncidence::PatchList & HexIncidence::verticePatches(vtkIdType vId)
+{
+    static const PatchList none;
+    if(vId < 0 || vId >= vtkIdType(vertPatches.size()))
+        return none;
+    return vertPatches[vId];
+}
+
+const HexIncidence::BlockList & HexIncidence::edgeBlocks(HexEdge *e)
+{
+    static const BlockList none;
+    std::map<HexEdge *,BlockList>::iterator it = edgeBlockMap.find(e);
+    if(it == edgeBlockMap.end())
+        return none;
+    return it->second;
+}
@@ -0,0 +1,106 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Incidence tables of the model: which edges, patches and blocks use a
+    vertice, and which blocks use an edge. They are updated when blocks,
+    edges and patches are added or removed, so questions like "is this
+    vertice still used" or "which blocks share this edge" only look at
+    the neighbourhood instead of looping over the whole model.
+    The tables are keyed on vertice ids, so an entity has to be removed
+    before its ids are changed and added again afterwards, or all ids
+    renumbered at once with remapVertices. build() refills everything
+    from the global lists.
+*/
+
+#ifndef HEXINCIDENCE_H
+#define HEXINCIDENCE_H
+
+#include <vtkObject.h>
+#include <vector>
+#include <map>
+
+class HexBlock;
+class HexEdge;
+class HexPatch;
+class HexCollection;
+class HexEdgeCollection;
+class HexPatchCollection;
+
+class HexIncidence : public vtkObject
+{
+    vtkTypeMacro(HexIncidence,vtkObject)
+
+protected:
+    HexIncidence();
+    ~HexIncidence();
+    HexIncidence(const HexIncidence&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexIncidence&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    typedef std::vector<HexBlock *> BlockList;
+    typedef std::vector<HexEdge *> EdgeList;
+    typedef std::vector<HexPatch *> PatchList;
+
+    //FUNCTIONS
+    static HexIncidence *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //empties and refills all tables from the global lists
+    void build(HexCollection *blocks, HexEdgeCollection *edges,
+               HexPatchCollection *patches);
+    void clear();
+
+    //vertice i is now newIds[i], -1 if it was dropped. Only unused
+    //vertices may be dropped, the entities themselves are unchanged.
+    void remapVertices(const std::vector<vtkIdType> &newIds);
+
+    //a block is registered on its vertices and its local edges,
+    //the edges and patches themselves are added separately.
+    void addBlock(HexBlock *hb);
+    void removeBlock(HexBlock *hb);
+    void addEdge(HexEdge *e);
+    //also forgets which blocks used the edge
+    void removeEdge(HexEdge *e);
+    void addPatch(HexPatch *p);
+    void removePatch(HexPatch *p);
+
+    //the entities using vertice vId, empty if none
+    const BlockList & verticeBlocks(vtkIdType vId);
+    const EdgeList & verticeEdges(vtkIdType vId);
+    const PatchList & verticePatches(vtkIdType vId);
+
+    //the blocks that have e among their local edges
+    const BlockList & edgeBlocks(HexEdge *e);
+
+private:
+    //DATA
+    std::vector<BlockList> vertBlocks;
+    std::vector<EdgeList> vertEdges;
+    std::vector<PatchList> vertPatches;
+    std::map<HexEdge *,BlockList> edgeBlockMap;
+};
+
+#endif // HEXINCIDENCE_H
@@ -0,0 +1,232 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexLabelRepresentation.h"
+#include "HexBlocker.h"
+#include "HexBlock.h"
+#include "HexPatch.h"
+#include "HexPatchCollection.h"
+#include "HexEdge.h"
+#include "HexEdgeCollection.h"
+#include "HexCollection.h"
+#include "HexDirtyItems.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkPoints.h>
+#include <vtkStringArray.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPointSetToLabelHierarchy.h>
+#include <vtkLabelPlacementMapper.h>
+#include <vtkTextProperty.h>
+#include <vtkActor2D.h>
+#include <sstream>
+
+vtkStandardNewMacro(HexLabelRepresentation);
+
+HexLabelRepresentation::HexLabelRepresentation()
+{
+    hexBlocker = NULL;
+    labelType = VERTICES;
+    dirty = vtkSmartPointer<HexDirtyItems>::New();
+    numVertices = 0;
+    anchors = vtkSmartPointer<vtkPoints>::New();
+    labels = vtkSmartPointer<vtkStringArray>::New();
+    labels->SetName("labels");
+
+    data = vtkSmartPointer<vtkPolyData>::New();
+    data->SetPoints(anchors);
+    data->GetPointData()->AddArray(labels);
+
+    hierarchy = vtkSmartPointer<vtkPointSetToLabelHierarchy>::New();
+#if VTK_MAJOR_VERSION >= 6
+    hierarchy->SetInputData(data);
+#else
+    hierarchy->SetInput(data);
+#endif
+    hierarchy->SetLabelArrayName("labels");
+
+    mapper = vtkSmartPointer<vtkLabelPlacementMapper>::New();
+    mapper->SetInputConnection(hierarchy->GetOutputPort());
+    //don't draw labels that are hidden by the model
+    mapper->UseDepthBufferOn();
+
+    actor = vtkSmartPointer<vtkActor2D>::New();
+    actor->SetMapper(mapper);
+}
+
+HexLabelRepresentation::~HexLabelRepresentation()
+{
+
+}
+
+void HexLabelRepresentation::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "type: " << labelType
+       << ", labels: " << labels->GetNumberOfValues() << std::endl;
+}
+
+void HexLabelRepresentation::setHexBlocker(HexBlocker *hexb, labelTypes type)
+{
+    hexBlocker = hexb;
+    labelType = type;
+    this->Modified();
+}
+
+void HexLabelRepresentation::setColor(double r, double g, double b)
+{
+    hierarchy->GetTextProperty()->SetColor(r,g,b);
+    hierarchy->Modified();
+}
+
+void HexLabelRepresentation::setVisibility(bool mode)
+{
+    actor->SetVisibility(mode);
+}
+
+HexCollection * HexLabelRepresentation::getList()
+{
+    switch(labelType)
+    {
+    case BLOCKS:
+        return hexBlocker->hexBlocks;
+    case PATCHES:
+        return hexBlocker->patches;
+    case EDGES:
+        return hexBlocker->edges;
+    default:
+        return NULL;
+    }
+}
+
+bool HexLabelRepresentation::needsRebuild()
+{
+    if(this->GetMTime() > buildTime)
+        return true;
+    if(labelType != VERTICES)
+        return getList() != list.GetPointer() || list->GetMTime() > buildTime;
+
+    //removed vertices are not labeled, unless a block uses them again
+    if(hexBlocker->vertices->GetNumberOfPoints() != numVertices ||
+            hexBlocker->getRemovedVerticesMTime() > buildTime)
+        return true;
+    return !hexBlocker->getRemovedVertices().empty() &&
+            hexBlocker->hexBlocks->GetMTime() > buildTime;
+}
+
+void HexLabelRepresentation::update()
+{
+    if(hexBlocker == NULL || !actor->GetVisibility())
+        return;
+    if(needsRebuild())
+    {
+        rebuild();
+        return;
+    }
+
+    if(labelType == VERTICES)
+    {
+        //the points don't tell which of them have moved, their
+        //positions are copied but the labels are kept
+        if(hexBlocker->vertices->GetMTime() <= anchorTime)
+            return;
+        for(vtkIdType i=0;i<vtkIdType(vertIds.size());i++)
+            updateAnchor(i);
+    }
+    else
+    {
+        //the items are modified when their vertices are moved
+        std::vector<vtkIdType> ids;
+        dirty->takeDirty(ids);
+        if(ids.empty())
+            return;
+        for(size_t i=0;i<ids.size();i++)
+            updateAnchor(ids[i]);
+    }
+    anchors->Modified();
+    data->Modified();
+    anchorTime.Modified();
+}
+
+void HexLabelRepresentation::rebuild()
+{
+    list = getList();
+    dirty->watch(list);
+
+    //the ids of the anchors, if they are not their positions
+    vertIds.clear();
+    vtkIdType n;
+    if(labelType == VERTICES)
+    {
+        numVertices = hexBlocker->vertices->GetNumberOfPoints();
+        for(vtkIdType i=0;i<numVertices;i++)
+        {
+            if(!hexBlocker->isVerticeRemoved(i))
+                vertIds.push_back(i);
+        }
+        n = vertIds.size();
+    }
+    else
+        n = list->GetNumberOfItems();
+
+    anchors->SetNumberOfPoints(n);
+    labels->SetNumberOfValues(n);
+    std::ostringstream id;
+    for(vtkIdType i=0;i<n;i++)
+    {
+        updateAnchor(i);
+        id.str("");
+        id << (labelType == VERTICES ? vertIds[i] : i);
+        labels->SetValue(i,id.str());
+    }
+
+    anchors->Modified();
+    labels->Modified();
+    data->Modified();
+    buildTime.Modified();
+    anchorTime.Modified();
+}
+
+void HexLabelRepresentation::updateAnchor(vtkIdType i)
+{
+    double c[3];
+    switch(labelType)
+    {
+    case VERTICES:
+        hexBlocker->vertices->GetPoint(vertIds[i],c);
+        break;
+    case BLOCKS:
+        HexBlock::SafeDownCast(list->GetItemAsObject(i))->getCenter(c);
+        break;
+    case PATCHES:
+        HexPatch::SafeDownCast(list->GetItemAsObject(i))->getCenter(c);
+        break;
+    case EDGES:
+        //the middle point, on the arc if the edge is an arc
+        HexEdge::SafeDownCast(list->GetItemAsObject(i))->calcParametricPoint(0.5,c);
+        break;
+    }
+    anchors->SetPoint(i,c);
+}
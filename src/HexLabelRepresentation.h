@@ -0,0 +1,115 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Id labels of the vertices, blocks, patches or edges. The labels are
+    placed by a label hierarchy (vtkPointSetToLabelHierarchy and
+    vtkLabelPlacementMapper) so only labels on screen are drawn, labels
+    behind the model are hidden using the depth buffer and overlapping
+    labels are thinned out. Labels are anchored at the vertices, or the
+    centers of blocks, patches and edges, and are only computed while
+    the labels are shown. The labels are made when objects are added or
+    removed; when they are moved only the anchors of the modified
+    blocks, patches and edges (HexDirtyItems) are moved.
+*/
+
+#ifndef HEXLABELREPRESENTATION_H
+#define HEXLABELREPRESENTATION_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+
+class HexBlocker;
+class HexCollection;
+class HexDirtyItems;
+class vtkPoints;
+class vtkPolyData;
+class vtkStringArray;
+class vtkPointSetToLabelHierarchy;
+class vtkLabelPlacementMapper;
+class vtkActor2D;
+
+class HexLabelRepresentation : public vtkObject
+{
+    vtkTypeMacro(HexLabelRepresentation,vtkObject)
+
+protected:
+    HexLabelRepresentation();
+    ~HexLabelRepresentation();
+    HexLabelRepresentation(const HexLabelRepresentation&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexLabelRepresentation&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    enum labelTypes{VERTICES=0,BLOCKS=1,PATCHES=2,EDGES=3};
+
+    //FUNCTIONS
+    static HexLabelRepresentation *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the model and what to label
+    void setHexBlocker(HexBlocker *hexb, labelTypes type);
+
+    //text color of the labels
+    void setColor(double r, double g, double b);
+
+    //show/hide
+    void setVisibility(bool mode);
+
+    //recomputes the anchors if the labeled objects have changed,
+    //does nothing while the labels are hidden.
+    void update();
+
+    //DATA
+    vtkSmartPointer<vtkActor2D> actor;
+
+private:
+    //FUNCTIONS
+    //the labeled blocks, patches or edges, NULL for vertices
+    HexCollection * getList();
+    //true if objects have been added or removed since the last rebuild
+    bool needsRebuild();
+    //fills anchors and labels
+    void rebuild();
+    //moves anchor i to its object
+    void updateAnchor(vtkIdType i);
+
+    //DATA
+    HexBlocker *hexBlocker;
+    labelTypes labelType;
+    vtkSmartPointer<HexCollection> list; //labeled at the last rebuild
+    vtkSmartPointer<HexDirtyItems> dirty; //items of list moved since
+    std::vector<vtkIdType> vertIds; //the vertice of each anchor
+    vtkIdType numVertices; //vertices at the last rebuild
+    vtkSmartPointer<vtkPoints> anchors;
+    vtkSmartPointer<vtkStringArray> labels;
+    vtkSmartPointer<vtkPolyData> data;
+    vtkSmartPointer<vtkPointSetToLabelHierarchy> hierarchy;
+    vtkSmartPointer<vtkLabelPlacementMapper> mapper;
+    vtkTimeStamp buildTime;
+    vtkTimeStamp anchorTime; //last move of the anchors
+};
+
+#endif // HEXLABELREPRESENTATION_H
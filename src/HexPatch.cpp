@@ -29,12 +29,6 @@ License
 #include <HexBlock.h>
 #include <vtkIdList.h>
 #include <vtkPoints.h>
-#include <vtkQuad.h>
-#include <vtkCellArray.h>
-#include <vtkPolyData.h>
-#include <vtkPolyDataMapper.h>
-#include <vtkActor.h>
-#include <vtkProperty.h>
 #include <vtkMath.h>
 
 
@@ -46,14 +40,9 @@ HexPatch::HexPatch()
     vertIds = vtkSmartPointer<vtkIdList>::New();
     vertIds->SetNumberOfIds(4);
 
-    quad = vtkSmartPointer<vtkQuad>::New();
-    quads = vtkSmartPointer<vtkCellArray>::New();
-    data = vtkSmartPointer<vtkPolyData>::New();
-    mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    actor  = vtkSmartPointer<vtkActor>::New();
-
     hasPrimaryHex = false;
     hasSecondaryHex = false;
+    resetColor();
 }
 
 HexPatch::~HexPatch()
@@ -108,42 +97,30 @@ void HexPatch::init(vtkSmartPointer<vtkIdList> vIds,
     primaryHex=hex;
     globalVertices = verts;
     vertIds=vIds;
-    for(vtkIdType i=0; i<4 ;i++)
-        quad->GetPointIds()->SetId(i,vIds->GetId(i));
-    quads->Allocate(1,1);
-    quads->InsertNextCell(quad);
-
-    data->SetPoints(globalVertices);
-    data->SetPolys(quads);
-#if VTK_MAJOR_VERSION >= 6
-    mapper->SetInputData(data);
-#else
-    mapper->SetInput(data);
-#endif    
-    actor->SetMapper(mapper);
-    actor->SetOrigin(actor->GetCenter());
-    actor->SetScale(0.6);
-    actor->GetProperty()->EdgeVisibilityOn();
+    this->Modified();
     resetColor();
 }
 
 void HexPatch::setColor(double r, double g, double b)
 {
-    actor->GetProperty()->SetColor(r,b,g);
-
+    color[0]=r;
+    color[1]=g;
+    color[2]=b;
+    //the representation redraws modified patches
+    this->Modified();
 }
 
 void HexPatch::resetColor()
 {
     if(!hasSecondaryHex)
     {
-        actor->GetProperty()->SetColor(0.2,0.9,0.2);
-        actor->GetProperty()->SetOpacity(1.0);
+        setColor(0.2,0.9,0.2);
+        opacity=1.0;
     }
     else
     {
-        actor->GetProperty()->SetColor(0.2,0.2,0.9);
-        actor->GetProperty()->SetOpacity(0.5);
+        setColor(0.2,0.2,0.9);
+        opacity=0.5;
     }
 }
 
@@ -222,9 +199,8 @@ void HexPatch::setHex(HexBlock *hex)
     {
         //std::cout << "setting secondary" <<  std::endl;
         secondaryHex=hex;
-        actor->SetOrigin(actor->GetCenter());
-        actor->SetScale(0.4);
         hasSecondaryHex=true;
+        this->Modified();
         resetColor();
     }
 
@@ -261,24 +237,17 @@ HexBlock* HexPatch::getSecondaryHexBlock()
 }
 
 
-void HexPatch::rescaleActor()
+double HexPatch::getShrinkFactor()
 {
-    double cog[3];
-    cog[0]=0.0;cog[1]=0.0;cog[2]=0.0;
-    for(vtkIdType i=0;i<vertIds->GetNumberOfIds();i++)
-    {
-        double pos[3];
-        globalVertices->GetPoint(vertIds->GetId(i),pos);
-        vtkMath::Add(cog,pos,cog);
-    }
-    vtkMath::MultiplyScalar(cog,0.25);
-//    std::cout << "centers is (" << cog[0] <<"," << cog[1] <<"," << cog[2] << ")" << std::endl;
-    actor->SetOrigin(cog);
-
     if(hasSecondaryHex)
-        actor->SetScale(0.4);
+        return 0.4;
     else
-        actor->SetScale(0.6);
+        return 0.6;
+}
+
+void HexPatch::rescaleActor()
+{
+    this->Modified();
 }
 
 void HexPatch::changeVertId(vtkIdType from, vtkIdType to)
@@ -290,13 +259,7 @@ void HexPatch::changeVertId(vtkIdType from, vtkIdType to)
 //                 << vertIds->GetId(0) << "," << vertIds->GetId(1) << ","
 //                 << vertIds->GetId(2) << "," << vertIds->GetId(3) << ") after (";
         vertIds->SetId(pos,to);
-        quad->GetPointIds()->SetId(pos,to);
-        vtkIdType pts[4];
-        pts[0]=vertIds->GetId(0);
-        pts[1]=vertIds->GetId(1);
-        pts[2]=vertIds->GetId(2);
-        pts[3]=vertIds->GetId(3);
-        quads->ReplaceCell(0,4,pts);
+        this->Modified();
 //        std::cout << vertIds->GetId(0) << "," << vertIds->GetId(1) << ","
 //        << vertIds->GetId(2) << "," << vertIds->GetId(3) << ")" << std::endl;
 //        data->Modified();
@@ -305,20 +268,15 @@ void HexPatch::changeVertId(vtkIdType from, vtkIdType to)
     }
 }
 
-void HexPatch::reduceVertId(vtkIdType vId)
+void HexPatch::remapVertIds(const std::vector<vtkIdType> &newIds)
 {
     for(vtkIdType i=0;i<vertIds->GetNumberOfIds();i++)
     {
         vtkIdType oldId = vertIds->GetId(i);
-        if(oldId > vId)
-            vertIds->SetId(i,oldId-1);
+        if(oldId < vtkIdType(newIds.size()))
+            vertIds->SetId(i,newIds[oldId]);
     }
-    vtkIdType pts[4];
-    pts[0]=vertIds->GetId(0);
-    pts[1]=vertIds->GetId(1);
-    pts[2]=vertIds->GetId(2);
-    pts[3]=vertIds->GetId(3);
-    quads->ReplaceCell(0,4,pts);
+    this->Modified();
 }
 
 void HexPatch::removeSafely(HexBlock * hex)
@@ -23,8 +23,8 @@ License
     The license is included in the file COPYING.
 
 Description
-    This class contains vtk objects for representation of a patch. It also
-    has pointers to primary and secondary hexBlock. If its an internal patch
+    This class contains the vertices and colour of a patch, it's drawn by
+    HexPatchRepresentation. It also has pointers to primary and secondary hexBlock. If its an internal patch
     then it has two connecteds blocks.
 */
 
@@ -34,15 +34,11 @@ Description
 #include <vtkSmartPointer.h>
 #include <vtkObject.h>
 #include <QTextStream>
+#include <vector>
 
 //pre declarations
 class vtkIdList;
 class vtkPoints;
-class vtkPolyDataMapper;
-class vtkActor;
-class vtkQuad;
-class vtkCellArray;
-class vtkPolyData;
 class HexBlock;
 
 class HexPatch : public vtkObject
@@ -74,7 +70,9 @@ public:
     bool equals(vtkSmartPointer<vtkIdList> otherIds);
     void orderVertices(); //not yet implemented,
 
+    //colour the patch is drawn with, see HexPatchRepresentation
     void setColor(double,double,double);
+    //green for boundary and transparent blue for internal patches
     void resetColor();
 
     //export vertices as ( 1 2 3 4 )
@@ -92,11 +90,15 @@ public:
     void getCenter(double c[3]);
 
     //if it has two block patch is scaled by 0.4 else 0.6
+    double getShrinkFactor();
+
+    //the patch is redrawn at next render
     void rescaleActor();
 
     //from and two are vertices ids in global list
     void changeVertId(vtkIdType from, vtkIdType to);
-    void reduceVertId(vtkIdType vId);
+    //renumbers the vertices, the new id of vertice i is newIds[i]
+    void remapVertIds(const std::vector<vtkIdType> &newIds);
 
     //if we only have one block then
     void removeSafely(HexBlock *hex);
@@ -108,15 +110,10 @@ public:
     //DATA
     vtkSmartPointer<vtkIdList> vertIds;
     vtkSmartPointer<vtkPoints> globalVertices;
-    //representations
-    vtkSmartPointer<vtkPolyDataMapper> mapper;
-    vtkSmartPointer<vtkActor> actor;
-
+    double color[3];
+    double opacity;
 
 private:
-    vtkSmartPointer<vtkQuad> quad;
-    vtkSmartPointer<vtkCellArray> quads;
-    vtkSmartPointer<vtkPolyData> data;
     HexBlock * primaryHex;
     HexBlock * secondaryHex;
     bool hasPrimaryHex;
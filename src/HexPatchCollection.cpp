@@ -0,0 +1,113 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexPatchCollection.h"
+#include "HexPatch.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+
+vtkStandardNewMacro(HexPatchCollection);
+
+HexPatchCollection::HexPatchCollection()
+{
+
+}
+
+HexPatchCollection::~HexPatchCollection()
+{
+
+}
+
+void HexPatchCollection::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "patches: " << this->GetNumberOfItems()
+       << ", indexed: " << index.size() << std::endl;
+}
+
+void HexPatchCollection::itemAdded(vtkObject *a)
+{
+    HexPatch *p = HexPatch::SafeDownCast(a);
+    if(p != NULL)
+        addToIndex(p);
+}
+
+void HexPatchCollection::itemRemoved(vtkObject *a)
+{
+    index.remove(a);
+}
+
+void HexPatchCollection::addToIndex(HexPatch *p)
+{
+    index.add(p,p->vertIds);
+}
+
+void HexPatchCollection::removeFromIndex(HexPatch *p)
+{
+    index.remove(p);
+}
+
+HexPatch * HexPatchCollection::findPatch(vtkIdType a, vtkIdType b,
+                                         vtkIdType c, vtkIdType d)
+{
+    vtkIdType ids[4] = {a,b,c,d};
+    return static_cast<HexPatch *>(index.find(ids,4));
+}
+
+HexPatch * HexPatchCollection::findPatch(vtkIdList *ids)
+{
+    if(ids->GetNumberOfIds() < 4)
+        return NULL;
+    return findPatch(ids->GetId(0),ids->GetId(1),ids->GetId(2),ids->GetId(3));
+}
+
+vtkIdType HexPatchCollection::findPatchId(vtkIdList *ids)
+{
+    HexPatch *p = findPatch(ids);
+    if(p == NULL)
+        return vtkIdType(-1);
+    return findItem(p);
+}
+
+void HexPatchCollection::findPatches(vtkIdList *ids, std::vector<HexPatch *> &found)
+{
+    if(ids->GetNumberOfIds() < 4)
+        return;
+    std::vector<vtkObject *> items;
+    index.findAll(ids->GetPointer(0),4,items);
+    for(size_t i=0;i<items.size();i++)
+        found.push_back(static_cast<HexPatch *>(items[i]));
+}
+
+void HexPatchCollection::rebuildIndex()
+{
+    index.clear();
+    for(vtkIdType i=0;i<this->GetNumberOfItems();i++)
+    {
+        HexPatch *p = HexPatch::SafeDownCast(this->GetItemAsObject(i));
+        if(p != NULL)
+            addToIndex(p);
+    }
+}
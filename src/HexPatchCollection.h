@@ -0,0 +1,90 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    The global list of patches. Like HexEdgeCollection it works as a
+    HexCollection and keeps an index (see HexVertIdsIndex), here from
+    the four vertice ids of a patch to the patch. Two patches with the
+    same vertices in any order are the same face, which is how
+    HexPatch::equals compares.
+*/
+
+#ifndef HEXPATCHCOLLECTION_H
+#define HEXPATCHCOLLECTION_H
+
+#include "HexCollection.h"
+#include "HexVertIdsIndex.h"
+#include <vector>
+
+class HexPatch;
+class vtkIdList;
+
+class HexPatchCollection : public HexCollection
+{
+    vtkTypeMacro(HexPatchCollection,HexCollection)
+
+protected:
+    HexPatchCollection();
+    ~HexPatchCollection();
+    HexPatchCollection(const HexPatchCollection&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexPatchCollection&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexPatchCollection *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //returns the patch with the four vertices in ids, in any
+    //order, or NULL if there is no such patch.
+    HexPatch * findPatch(vtkIdList *ids);
+    HexPatch * findPatch(vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType d);
+
+    //as above but returns the position in the list, or -1.
+    vtkIdType findPatchId(vtkIdList *ids);
+
+    //appends every patch with the four vertices in ids, there
+    //may be more than one e.g. while reading.
+    void findPatches(vtkIdList *ids, std::vector<HexPatch *> &found);
+
+    //clears and refills the index. Has to be called when the
+    //vertice ids of the patches in the list have been changed.
+    void rebuildIndex();
+
+    //for changing the ids of a few patches: put them in the index
+    //again after the change.
+    void removeFromIndex(HexPatch *p);
+    void addToIndex(HexPatch *p);
+
+protected:
+    //keep the index in step with the list
+    void itemAdded(vtkObject *a);
+    void itemRemoved(vtkObject *a);
+
+private:
+    //DATA
+    HexVertIdsIndex index;
+};
+
+#endif // HEXPATCHCOLLECTION_H
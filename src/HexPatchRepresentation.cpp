@@ -0,0 +1,186 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexPatchRepresentation.h"
+#include "HexPatch.h"
+#include "HexPatchCollection.h"
+#include "HexDirtyItems.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkIntArray.h>
+#include <vtkCellData.h>
+#include <vtkPolyData.h>
+#include <vtkLookupTable.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkActor.h>
+#include <vtkCellLocator.h>
+#include <vtkProperty.h>
+#include <vtkMath.h>
+
+vtkStandardNewMacro(HexPatchRepresentation);
+
+HexPatchRepresentation::HexPatchRepresentation()
+{
+    dirty = vtkSmartPointer<HexDirtyItems>::New();
+    points = vtkSmartPointer<vtkPoints>::New();
+    quads = vtkSmartPointer<vtkCellArray>::New();
+    patchIds = vtkSmartPointer<vtkIntArray>::New();
+    patchIds->SetName("patchIds");
+
+    data = vtkSmartPointer<vtkPolyData>::New();
+    data->SetPoints(points);
+    data->SetPolys(quads);
+    data->GetCellData()->SetScalars(patchIds);
+
+    colors = vtkSmartPointer<vtkLookupTable>::New();
+
+    mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+#if VTK_MAJOR_VERSION >= 6
+    mapper->SetInputData(data);
+#else
+    mapper->SetInput(data);
+#endif
+    mapper->SetLookupTable(colors);
+    mapper->SetScalarModeToUseCellData();
+    mapper->UseLookupTableScalarRangeOn();
+
+    actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetMapper(mapper);
+
+    locator = vtkSmartPointer<vtkCellLocator>::New();
+    actor->GetProperty()->EdgeVisibilityOn();
+}
+
+HexPatchRepresentation::~HexPatchRepresentation()
+{
+
+}
+
+void HexPatchRepresentation::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "patches: " << quads->GetNumberOfCells() << std::endl;
+}
+
+void HexPatchRepresentation::setPatches(HexPatchCollection *patchList, vtkPoints *verts)
+{
+    patches = patchList;
+    vertices = verts;
+    this->Modified();
+}
+
+void HexPatchRepresentation::update()
+{
+    if(patches == NULL)
+        return;
+
+    if(patches->GetMTime() > buildTime || this->GetMTime() > buildTime)
+    {
+        rebuild();
+        return;
+    }
+
+    //only the patches that are marked as modified, e.g. by
+    //rescaleActor when their vertices have moved
+    std::vector<vtkIdType> ids;
+    dirty->takeDirty(ids);
+    if(ids.empty())
+        return;
+    for(size_t i=0;i<ids.size();i++)
+        updatePatch(ids[i]);
+    points->Modified();
+    colors->Modified();
+    data->Modified();
+}
+
+void HexPatchRepresentation::rebuild()
+{
+    dirty->watch(patches);
+
+    vtkIdType numPatches = patches->GetNumberOfItems();
+    quads->Initialize();
+    patchIds->Initialize();
+    points->SetNumberOfPoints(4*numPatches);
+    if(numPatches > 0)
+    {
+        colors->SetNumberOfTableValues(numPatches);
+        //one table value per patch id
+        colors->SetTableRange(-0.5,numPatches-0.5);
+    }
+
+    for(vtkIdType i=0;i<numPatches;i++)
+    {
+        quads->InsertNextCell(4);
+        for(vtkIdType k=0;k<4;k++)
+            quads->InsertCellPoint(4*i+k);
+        patchIds->InsertNextValue(i);
+        updatePatch(i);
+    }
+
+    points->Modified();
+    colors->Modified();
+    data->Modified();
+    buildTime.Modified();
+}
+
+void HexPatchRepresentation::updatePatch(vtkIdType i)
+{
+    HexPatch *p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
+    double c[3];
+    p->getCenter(c);
+    double s = p->getShrinkFactor();
+    for(vtkIdType k=0;k<4;k++)
+    {
+        //corner = c + s*(v - c)
+        double pos[3];
+        vertices->GetPoint(p->vertIds->GetId(k),pos);
+        vtkMath::Subtract(pos,c,pos);
+        vtkMath::MultiplyScalar(pos,s);
+        vtkMath::Add(c,pos,pos);
+        points->SetPoint(4*i+k,pos);
+    }
+    colors->SetTableValue(i,p->color[0],p->color[1],p->color[2],p->opacity);
+}
+
+vtkIdType HexPatchRepresentation::getPatchId(vtkIdType cellId)
+{
+    if(cellId < 0 || cellId >= patchIds->GetNumberOfTuples())
+        return -1;
+    return patchIds->GetValue(cellId);
+}
+
+vtkCellLocator * HexPatchRepresentation::getLocator()
+{
+    vtkDataSet *out = data;
+    if(locator->GetDataSet() != out || out->GetMTime() > locatorTime)
+    {
+        locator->SetDataSet(out);
+        locator->BuildLocator();
+        locatorTime.Modified();
+    }
+    return locator;
+}
@@ -0,0 +1,112 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Draws all patches in the model with a single polydata, mapper and
+    actor, as HexEdgeRepresentation does for the edges. Each patch is
+    one quad shrunk towards its center, 0.6 for boundary patches and 0.4
+    for internal ones, so the blocks can be seen through the gaps. The
+    shrunk points are computed here, from the vertices, for the patches
+    that have been modified since the last update (see HexDirtyItems),
+    e.g. by HexPatch::rescaleActor or setColor. The position of the
+    patch in the list is stored as cell scalar and the colour and
+    opacity are looked up from it in a table.
+*/
+
+#ifndef HEXPATCHREPRESENTATION_H
+#define HEXPATCHREPRESENTATION_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+class HexPatch;
+class HexPatchCollection;
+class HexDirtyItems;
+class vtkPoints;
+class vtkCellArray;
+class vtkIntArray;
+class vtkPolyData;
+class vtkLookupTable;
+class vtkPolyDataMapper;
+class vtkActor;
+class vtkCellLocator;
+
+class HexPatchRepresentation : public vtkObject
+{
+    vtkTypeMacro(HexPatchRepresentation,vtkObject)
+
+protected:
+    HexPatchRepresentation();
+    ~HexPatchRepresentation();
+    HexPatchRepresentation(const HexPatchRepresentation&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexPatchRepresentation&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexPatchRepresentation *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the patches to draw and the vertices they refer to
+    void setPatches(HexPatchCollection *patchList, vtkPoints *verts);
+
+    //brings the polydata and colours up to date with the patches,
+    //only what has changed since the last call is redone.
+    void update();
+
+    //the position in the patch list of the patch drawn by cell cellId,
+    //-1 if there is no such cell.
+    vtkIdType getPatchId(vtkIdType cellId);
+
+    //locator of the rendered data for the picker, rebuilt
+    //if the data has changed since the last pick
+    vtkCellLocator * getLocator();
+
+    //DATA
+    vtkSmartPointer<vtkActor> actor;
+
+private:
+    //FUNCTIONS
+    //recreates the quads, corners and colours of all patches
+    void rebuild();
+    //shrunk corners and colour of patch i
+    void updatePatch(vtkIdType i);
+
+    //DATA
+    vtkSmartPointer<HexPatchCollection> patches;
+    vtkSmartPointer<vtkPoints> vertices;
+    vtkSmartPointer<HexDirtyItems> dirty;
+    vtkSmartPointer<vtkPoints> points;
+    vtkSmartPointer<vtkCellArray> quads;
+    vtkSmartPointer<vtkIntArray> patchIds;
+    vtkSmartPointer<vtkPolyData> data;
+    vtkSmartPointer<vtkLookupTable> colors;
+    vtkSmartPointer<vtkPolyDataMapper> mapper;
+
+    vtkTimeStamp buildTime;
+    vtkSmartPointer<vtkCellLocator> locator;
+    vtkTimeStamp locatorTime;
+};
+
+#endif // HEXPATCHREPRESENTATION_H
@@ -26,16 +26,19 @@ License
 #include "HexReader.h"
 #include "HexBlocker.h"
 #include "HexEdge.h"
+#include "HexEdgeCollection.h"
 #include "HexPatch.h"
+#include "HexPatchCollection.h"
 #include "HexBlock.h"
 #include "HexBC.h"
 
-#include "vtkCollection.h"
+#include "HexCollection.h"
 #include "vtkPoints.h"
 #include "vtkIdList.h"
 
 #include <iostream>
-#include <QtGui>
+#include <QString>
+#include <QStringList>
 
 #include <QTextStream>
 #include <QRegExp>
@@ -43,10 +46,10 @@ License
 HexReader::HexReader()
 {
     readVertices  = vtkSmartPointer<vtkPoints>::New();
-    readPatches = vtkSmartPointer<vtkCollection>::New();
-    readBlocks  = vtkSmartPointer<vtkCollection>::New();
-    readEdges   = vtkSmartPointer<vtkCollection>::New();
-    readBCs     = vtkSmartPointer<vtkCollection>::New();
+    readPatches = vtkSmartPointer<HexPatchCollection>::New();
+    readBlocks  = vtkSmartPointer<HexCollection>::New();
+    readEdges   = vtkSmartPointer<HexEdgeCollection>::New();
+    readBCs     = vtkSmartPointer<HexCollection>::New();
     convertToMeters = 1.0;
 }
 
@@ -59,14 +62,14 @@ int HexReader::readBlockMeshDict(QTextStream *in)
     getScale(); // Read convertToMeters value
 
     //Read vertices
-    getVertices();
+    bool ok = getVertices();
 
-    getBlocks();
+    ok = ok && getBlocks();
 
     getBCs();
 
     getEdges();
-    return 0;
+    return ok ? 0 : 1;
 
 }
 
@@ -94,7 +97,7 @@ QString HexReader::readFileContents(QTextStream *in)
             }
             if(newline.isNull())
             {
-                std::cout << "Error while skiping /* .. */ on row "
+                std::cerr << "Error while skiping /* .. */ on row "
                           << rownr << ". end of file reached inside comment block." << std::endl;
             }
             line.append(newline.remove(0,starslash+2));
@@ -124,7 +127,7 @@ QString HexReader::getEntry(QString entry, QString container)
     int startEntry = container.indexOf(entry);
     if(startEntry<0)
     {
-        std::cout << "Warning: Entry \""
+        std::cerr << "Warning: Entry \""
                   << entry.toAscii().data()
                   << "\" was not found" << std::endl;
         return QString("");
@@ -151,7 +154,7 @@ QString HexReader::getEntry(QString entry, QString container)
         }
         else if(parenthesisLevel<0)
         {
-            std::cout << "Error unmatching parenthesis while getting "
+            std::cerr << "Error unmatching parenthesis while getting "
                       << entry.toAscii().data() << std::endl;
         }
         returnEntry.append(QChar(contentsFromStart.at(i)));
@@ -168,7 +171,7 @@ bool HexReader::getScale()
     convertToMeters = c2mList.at(1).toDouble(&ok);
     if(!ok)
     {
-        std::cout << "error reading convertToMeters: " << c2mString.toAscii().data() << std::endl;
+        std::cerr << "error reading convertToMeters: " << c2mString.toAscii().data() << std::endl;
         return false;
     }
     return true;
@@ -185,6 +188,11 @@ bool HexReader::getVertices()
         QString vert = vertsList.at(i);
         vert=vert.replace(QString(","),QString(" ")).replace(QString(")"),QString(" ")).simplified();
         QStringList vertCompList = vert.split(QString(" "),QString::SkipEmptyParts);
+        if(vertCompList.size() < 3)
+        {
+            std::cerr << "error reading vertice " << i-2 <<std::endl;
+            return false;
+        }
 
         double coords[3]; bool ok[3];
         coords[0] = vertCompList.at(0).toDouble(&ok[0]);
@@ -192,7 +200,7 @@ bool HexReader::getVertices()
         coords[2] = vertCompList.at(2).toDouble(&ok[2]);
         if(!(ok[0]&&ok[1]&&ok[2]))
         {
-            std::cout << "error reading vertice " << i-2 <<std::endl;
+            std::cerr << "error reading vertice " << i-2 <<std::endl;
             return false;
         }
 
@@ -220,7 +228,7 @@ bool HexReader::getBlocks()
         QStringList entries = hexList.at(i).split(QString(")"),QString::SkipEmptyParts);
         if(entries.size() < 3)
         {
-            std::cout << "error while reading block " << readBlocks->GetNumberOfItems() << std::endl;
+            std::cerr << "error while reading block " << readBlocks->GetNumberOfItems() << std::endl;
             return false;
         }
 
@@ -238,7 +246,7 @@ bool HexReader::getBlocks()
 
         if(vertIdsList.size() < 8)
         {
-            std::cout << "error while reading block " << readBlocks->GetNumberOfItems() << std::endl;
+            std::cerr << "error while reading block " << readBlocks->GetNumberOfItems() << std::endl;
             return false;
         }
 
@@ -266,7 +274,7 @@ bool HexReader::getBlocks()
 
         if(!(ok[0]&&ok[1]&&ok[2]))
         {
-            std::cout << "error reading cell numbers of hexBlock"<< readBlocks->GetNumberOfItems() << i-2 <<std::endl;
+            std::cerr << "error reading cell numbers of hexBlock"<< readBlocks->GetNumberOfItems() << i-2 <<std::endl;
             return false;
         }
 
@@ -355,7 +363,7 @@ bool HexReader::getBlocks()
 
 void HexReader::errorInGrading(vtkIdType hexNum,QString entry)
 {
-    std::cout << "Error while reading grading of block "
+    std::cerr << "Error while reading grading of block "
               << hexNum << "the entry was: " << std::endl
               << entry.toAscii().data()
               << "setting it to 1" << std::endl;
@@ -366,7 +374,7 @@ bool HexReader::getBCs()
     QString boun = getEntry(QString("boundary"),fileContents);
     if(boun.isEmpty())
     {
-        std::cout << "Did not find the entry \"boundary\". BCs have not been read." << std::endl;
+        std::cerr << "Did not find the entry \"boundary\". BCs have not been read." << std::endl;
         return false;
     }
 
@@ -383,7 +391,7 @@ bool HexReader::getBCs()
         QString name = listBCs.at(i).simplified().split("{").at(0).simplified();
         if(name.isEmpty())
         {
-            std::cout << "Something went wrong when reading bc nr " << i<< std::endl;
+            std::cerr << "Something went wrong when reading bc nr " << i<< std::endl;
             return false;
         }
         newBC->name = name.toAscii().data();
@@ -394,7 +402,7 @@ bool HexReader::getBCs()
                 .split(QString(" "),QString::SkipEmptyParts);
         if(typeList.size() < 2)
         {
-            std::cout << "Error reading boundary " << name.toAscii().data() << std::endl;
+            std::cerr << "Error reading boundary " << name.toAscii().data() << std::endl;
             return false;
         }
 
@@ -410,7 +418,7 @@ bool HexReader::getBCs()
             QStringList patchIdsList = patchesList.at(j).simplified().split(" ",QString::SkipEmptyParts);
             if(patchIdsList.size() < 4)
             {
-                std::cout << " Error while reading boundary " << name.toAscii().data()
+                std::cerr << " Error while reading boundary " << name.toAscii().data()
                           << " patch " << j << " has to few entries" <<std::endl;
                 return false;
             }
@@ -425,7 +433,7 @@ bool HexReader::getBCs()
 
             if(!(ok[0]&&ok[1]&&ok[2]&&ok[3]))
             {
-                std::cout << " Error while reading boundary " << name.toAscii().data()
+                std::cerr << " Error while reading boundary " << name.toAscii().data()
                           << " patch " << j << " invalid entry" <<std::endl;
                 return false;
             }
@@ -550,25 +558,19 @@ bool HexReader::getEdges()
 
 vtkIdType HexReader::findEge(vtkIdType vId0, vtkIdType vId1)
 {
-    for(vtkIdType i=0;i<readEdges->GetNumberOfItems();i++)
-    {
-        HexEdge *e = HexEdge::SafeDownCast(
-                    readEdges->GetItemAsObject(i));
-        if(e->hasVertice(vId0) && e->hasVertice(vId1) )
-        {
-            //check for correct order
-            if(e->vertIds->GetId(0)!=vId0)
-                std::cout << "Warning: edge (" << vId0 <<" " << vId1 <<")"
-                          << " was prescribed with wrong order. This could cause problems." <<std::endl;
-            return i;
-        }
-    }
-    return -1;
-
+    HexEdge *e = readEdges->findEdge(vId0,vId1);
+    if(e == NULL)
+        return -1;
+
+    //check for correct order
+    if(e->vertIds->GetId(0)!=vId0)
+        std::cerr << "Warning: edge (" << vId0 <<" " << vId1 <<")"
+                  << " was prescribed with wrong order. This could cause problems." <<std::endl;
+    return readEdges->IsItemPresent(e)-1;
 }
 
 void HexReader::badEdgeEntry(QString edgeDict)
 {
-    std::cout << "Warning can\'t parse edgeDict: " << edgeDict.toAscii().data()
+    std::cerr << "Warning can\'t parse edgeDict: " << edgeDict.toAscii().data()
               << ". Note that some types are not yet supported." << std::endl;
 }
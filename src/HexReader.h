@@ -36,9 +36,11 @@ Description
 #include <vtkSmartPointer.h>
 
 //Pre declarations
-class vtkCollection;
+class HexCollection;
 class HexEdge;
+class HexEdgeCollection;
 class HexPatch;
+class HexPatchCollection;
 class HexBC;
 class HexBlock;
 class QTextStream;
@@ -54,13 +56,15 @@ public:
     HexReader();
 
     //FUNCTIONS
+    //returns 0 if the vertices and blocks were read, the errors
+    //are printed to std::cerr
     int readBlockMeshDict(QTextStream *in);
     //DATA
     vtkSmartPointer<vtkPoints>     readVertices;
-    vtkSmartPointer<vtkCollection> readPatches; //global patch list
-    vtkSmartPointer<vtkCollection> readBlocks;  //read blocks
-    vtkSmartPointer<vtkCollection> readBCs; //read boundary conditions
-    vtkSmartPointer<vtkCollection> readEdges; //read edges
+    vtkSmartPointer<HexPatchCollection> readPatches; //global patch list
+    vtkSmartPointer<HexCollection> readBlocks;  //read blocks
+    vtkSmartPointer<HexCollection> readBCs; //read boundary conditions
+    vtkSmartPointer<HexEdgeCollection> readEdges; //read edges
 
     QString edgesDict; //such as egdes or mergePairs
     double convertToMeters;
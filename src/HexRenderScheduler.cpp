@@ -0,0 +1,131 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexRenderScheduler.h"
+#include "HexView.h"
+
+bool HexRenderScheduler::reportOperations = false;
+
+HexRenderScheduler::HexRenderScheduler(HexView *view) : QObject()
+{
+    hexView = view;
+    numPending = 0;
+    opRunning = false;
+    opEnded = false;
+    timer.setSingleShot(true);
+    timer.setInterval(0);
+    connect(&timer,SIGNAL(timeout()),this,SLOT(timeout()));
+    resetCounters();
+}
+
+void HexRenderScheduler::requestRender()
+{
+    numRequests++;
+    numPending++;
+    if(opRunning)
+        numOpRequests++;
+    if(!timer.isActive())
+        timer.start();
+}
+
+bool HexRenderScheduler::isPending()
+{
+    return numPending > 0;
+}
+
+void HexRenderScheduler::renderNow()
+{
+    timer.stop();
+    numLastRequests = numPending;
+    if(numPending > maxRequests)
+        maxRequests = numPending;
+    numPending = 0;
+    numRenders++;
+    if(opRunning)
+        numOpRenders++;
+    hexView->renderNow();
+}
+
+void HexRenderScheduler::timeout()
+{
+    if(numPending > 0)
+        renderNow();
+    if(opRunning && opEnded)
+        finishOperation();
+}
+
+void HexRenderScheduler::beginOperation(const std::string &name)
+{
+    if(opRunning)
+        return;
+    opName = name;
+    opRunning = true;
+    opEnded = false;
+    numOpRequests = 0;
+    numOpRenders = 0;
+}
+
+void HexRenderScheduler::endOperation()
+{
+    if(!opRunning)
+        return;
+    //the requests of e.g. a triggered action come after the mouse
+    //release, wait for the event loop
+    opEnded = true;
+    if(!timer.isActive())
+        timer.start();
+}
+
+void HexRenderScheduler::finishOperation()
+{
+    opRunning = false;
+    opEnded = false;
+    if(reportOperations)
+        std::cout << opName << ": render requests: " << numOpRequests
+                  << ", renders: " << numOpRenders << std::endl;
+}
+
+void HexRenderScheduler::resetCounters()
+{
+    numRequests = 0;
+    numRenders = 0;
+    numLastRequests = 0;
+    maxRequests = 0;
+    numOpRequests = 0;
+    numOpRenders = 0;
+}
+
+void HexRenderScheduler::setReportOperations(bool report)
+{
+    reportOperations = report;
+}
+
+void HexRenderScheduler::printCounters(std::ostream &os)
+{
+    os << "render requests: " << numRequests
+       << ", renders: " << numRenders
+       << ", requests in last render: " << numLastRequests
+       << ", most requests in one render: " << maxRequests << std::endl;
+}
@@ -0,0 +1,100 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Collapses render requests into one render per pass of the Qt event
+    loop. HexView::render only asks for a render; the first request
+    starts a zero timeout timer and the render is done when control is
+    back in the event loop, however many requests came in between. It
+    counts the requests and the renders that actually ran, in total and
+    for each operation, i.e. a user action such as a click, a drag or a
+    key press (see MainWindow::eventFilter). Started with -renderstats
+    the counters of every operation are printed when it's over.
+*/
+
+#ifndef HEXRENDERSCHEDULER_H
+#define HEXRENDERSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <iostream>
+#include <string>
+
+class HexView;
+
+class HexRenderScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    HexRenderScheduler(HexView *view);
+
+    //render at the next pass of the event loop
+    void requestRender();
+
+    //true if a render has been requested but not yet done
+    bool isPending();
+
+    //an operation lasts from beginOperation until the first pass of
+    //the event loop after endOperation, so the render it asked for is
+    //counted. A begin while an operation is going on is ignored.
+    void beginOperation(const std::string &name);
+    void endOperation();
+
+    //zero the counters, a requested render is still done
+    void resetCounters();
+    //prints requests, renders and requests in the last render
+    void printCounters(std::ostream &os);
+    //print the counters of every operation when it's over,
+    //for all schedulers
+    static void setReportOperations(bool report);
+
+    //DATA
+    int numRequests;        //requests since resetCounters
+    int numRenders;         //renders actually done
+    int numLastRequests;    //requests collapsed into the last render
+    int maxRequests;        //most requests collapsed into one render
+    int numOpRequests;      //requests of the current or last operation
+    int numOpRenders;       //renders of the current or last operation
+
+public slots:
+    //does the requested render now
+    void renderNow();
+
+private slots:
+    //renders if requested and ends an operation that is over
+    void timeout();
+
+private:
+    void finishOperation();
+
+    HexView *hexView;
+    QTimer timer;
+    int numPending;
+    std::string opName;
+    bool opRunning;     //between beginOperation and its end
+    bool opEnded;       //endOperation called, over at next timeout
+    static bool reportOperations;
+};
+
+#endif // HEXRENDERSCHEDULER_H
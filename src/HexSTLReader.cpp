@@ -0,0 +1,425 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexSTLReader.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkPolyData.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkIntArray.h>
+#include <vtkSmartPointer.h>
+
+#include <QFile>
+#include <QByteArray>
+#include <QtEndian>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+
+//adds the points of the file to the coordinate array, when merging
+//points equal to one already added are found by an open addressing
+//hash table of point ids.
+class HexSTLPoints
+{
+public:
+    HexSTLPoints(vtkFloatArray *c, bool m) : coords(c), merge(m), numPoints(0) {}
+
+    bool merging() { return merge; }
+
+    //n points written directly by the caller
+    float * writePointer(vtkIdType n)
+    {
+        coords->SetNumberOfTuples(n);
+        numPoints = n;
+        return coords->GetPointer(0);
+    }
+
+    vtkIdType add(const float p[3])
+    {
+        if(!merge)
+        {
+            coords->InsertTuple(numPoints,p);
+            return numPoints++;
+        }
+        if(2*(numPoints+1) > vtkIdType(table.size()))
+            grow();
+        size_t h = hash(p) & (table.size()-1);
+        while(table[h] >= 0)
+        {
+            if(std::memcmp(coords->GetPointer(3*table[h]),p,3*sizeof(float)) == 0)
+                return table[h];
+            h = (h+1) & (table.size()-1);
+        }
+        coords->InsertTuple(numPoints,p);
+        table[h] = numPoints;
+        return numPoints++;
+    }
+
+    //drops the unused end of the array
+    void finish()
+    {
+        coords->SetNumberOfTuples(numPoints);
+        coords->Squeeze();
+        std::vector<vtkIdType>().swap(table);
+    }
+
+private:
+    //of the bits, so only exactly equal points are merged
+    static size_t hash(const float p[3])
+    {
+        quint32 b[3];
+        std::memcpy(b,p,sizeof(b));
+        size_t h = (b[0]*73856093u) ^ (b[1]*19349663u) ^ (b[2]*83492791u);
+        return h ^ (h >> 16);
+    }
+
+    void grow()
+    {
+        size_t size = table.size() < 1024 ? 1024 : 2*table.size();
+        table.assign(size,-1);
+        for(vtkIdType i=0;i<numPoints;i++)
+        {
+            size_t h = hash(coords->GetPointer(3*i)) & (size-1);
+            while(table[h] >= 0)
+                h = (h+1) & (size-1);
+            table[h] = i;
+        }
+    }
+
+    vtkFloatArray *coords;
+    bool merge;
+    vtkIdType numPoints;
+    std::vector<vtkIdType> table;
+};
+
+//default name of solid i
+static std::string solidName(const std::string &name, int i)
+{
+    if(!name.empty())
+        return name;
+    std::ostringstream os;
+    os << "solid" << i;
+    return os.str();
+}
+
+//the next whitespace separated token of [p,end), false at the end
+static bool nextToken(const char *&p, const char *end, const char *&tok, int &len)
+{
+    while(p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        p++;
+    if(p >= end)
+        return false;
+    tok = p;
+    while(p < end && !(*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        p++;
+    len = int(p-tok);
+    return true;
+}
+
+static bool tokenIs(const char *tok, int len, const char *word)
+{
+    return int(std::strlen(word)) == len && std::strncmp(tok,word,len) == 0;
+}
+
+vtkStandardNewMacro(HexSTLReader);
+
+HexSTLReader::HexSTLReader()
+{
+    FileName = NULL;
+    Merging = 0;
+    this->SetNumberOfInputPorts(0);
+}
+
+HexSTLReader::~HexSTLReader()
+{
+    this->SetFileName(NULL);
+}
+
+void HexSTLReader::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "file: " << (FileName ? FileName : "(none)")
+       << ", merging: " << Merging
+       << ", solids: " << solidNames.size() << std::endl;
+}
+
+int HexSTLReader::GetNumberOfSolids()
+{
+    return int(solidNames.size());
+}
+
+const char * HexSTLReader::GetSolidName(int i)
+{
+    if(i < 0 || i >= int(solidNames.size()))
+        return NULL;
+    return solidNames[i].c_str();
+}
+
+int HexSTLReader::RequestData(vtkInformation *, vtkInformationVector **,
+                              vtkInformationVector *outputVector)
+{
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    solidNames.clear();
+    if(FileName == NULL)
+    {
+        std::cout << "HexSTLReader: no file name" << std::endl;
+        return 0;
+    }
+
+    QFile file(FileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        std::cout << "HexSTLReader: could not open " << FileName << std::endl;
+        return 0;
+    }
+    qint64 size = file.size();
+    uchar *data = file.map(0,size);
+    if(data == NULL)
+    {
+        std::cout << "HexSTLReader: could not map " << FileName << std::endl;
+        return 0;
+    }
+
+    vtkSmartPointer<vtkFloatArray> coords = vtkSmartPointer<vtkFloatArray>::New();
+    coords->SetNumberOfComponents(3);
+    vtkSmartPointer<vtkIdTypeArray> conn = vtkSmartPointer<vtkIdTypeArray>::New();
+    vtkSmartPointer<vtkIntArray> regions = vtkSmartPointer<vtkIntArray>::New();
+    regions->SetName("regionIds");
+    HexSTLPoints points(coords,Merging != 0);
+
+    bool ok;
+    if(isBinary(data,size))
+        ok = readBinary(data,size,points,conn,regions);
+    else
+        ok = readAscii(reinterpret_cast<const char *>(data),size,points,conn,regions);
+    file.unmap(data);
+    if(!ok)
+    {
+        std::cout << "HexSTLReader: error reading " << FileName << std::endl;
+        return 0;
+    }
+    points.finish();
+
+    vtkSmartPointer<vtkPoints> pts = vtkSmartPointer<vtkPoints>::New();
+    pts->SetData(coords);
+    vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->SetCells(regions->GetNumberOfTuples(),conn);
+
+    output->SetPoints(pts);
+    output->SetPolys(polys);
+    output->GetCellData()->AddArray(regions);
+    return 1;
+}
+
+void HexSTLReader::MergePoints(vtkPolyData *input, vtkPolyData *output)
+{
+    vtkFloatArray *in = NULL;
+    if(input->GetPoints())
+        in = vtkFloatArray::SafeDownCast(input->GetPoints()->GetData());
+    if(in == NULL)
+    {
+        //not the output of a reader, nothing to merge by
+        output->ShallowCopy(input);
+        return;
+    }
+
+    vtkSmartPointer<vtkFloatArray> coords = vtkSmartPointer<vtkFloatArray>::New();
+    coords->SetNumberOfComponents(3);
+    HexSTLPoints points(coords,true);
+    vtkIdType numPts = in->GetNumberOfTuples();
+    std::vector<vtkIdType> newIds(numPts);
+    const float *p = in->GetPointer(0);
+    for(vtkIdType i=0;i<numPts;i++)
+        newIds[i] = points.add(p+3*i);
+    points.finish();
+
+    //cells are stored as the number of points followed by the ids
+    vtkSmartPointer<vtkIdTypeArray> conn = vtkSmartPointer<vtkIdTypeArray>::New();
+    conn->DeepCopy(input->GetPolys()->GetData());
+    vtkIdType *c = conn->GetPointer(0);
+    vtkIdType *end = c + conn->GetNumberOfTuples();
+    while(c < end)
+    {
+        vtkIdType n = *c++;
+        for(vtkIdType j=0;j<n;j++,c++)
+            *c = newIds[*c];
+    }
+
+    vtkSmartPointer<vtkPoints> pts = vtkSmartPointer<vtkPoints>::New();
+    pts->SetData(coords);
+    vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->SetCells(input->GetNumberOfPolys(),conn);
+
+    output->Initialize();
+    output->SetPoints(pts);
+    output->SetPolys(polys);
+    output->GetCellData()->ShallowCopy(input->GetCellData());
+}
+
+bool HexSTLReader::isBinary(const unsigned char *data, qint64 size)
+{
+    if(size < 84)
+        return false;
+    quint32 n = qFromLittleEndian<quint32>(data+80);
+    qint64 needed = 84 + 50*qint64(n);
+    if(size == needed)
+        return true;
+    //some exporters write bytes after the triangles, then only a
+    //header that doesn't look like an ASCII file tells it's binary
+    return size > needed && std::memcmp(data,"solid",5) != 0;
+}
+
+bool HexSTLReader::readBinary(const unsigned char *data, qint64, HexSTLPoints &points,
+                              vtkIdTypeArray *conn, vtkIntArray *regions)
+{
+    //80 byte header, number of triangles, and 50 bytes per triangle:
+    //normal, three vertices and two unused bytes
+    vtkIdType n = qFromLittleEndian<quint32>(data+80);
+    const unsigned char *tri = data+84;
+
+    conn->SetNumberOfValues(4*n);
+    vtkIdType *c = conn->GetPointer(0);
+    if(points.merging())
+    {
+        for(vtkIdType i=0;i<n;i++,tri+=50)
+        {
+            float v[9];
+            std::memcpy(v,tri+12,sizeof(v));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+            for(int j=0;j<9;j++)
+            {
+                quint32 b = qFromLittleEndian<quint32>(reinterpret_cast<uchar *>(&v[j]));
+                std::memcpy(&v[j],&b,4);
+            }
+#endif
+            *c++ = 3;
+            *c++ = points.add(v);
+            *c++ = points.add(v+3);
+            *c++ = points.add(v+6);
+        }
+    }
+    else
+    {
+        //the vertices straight from the file to the points
+        float *v = points.writePointer(3*n);
+        for(vtkIdType i=0;i<n;i++,tri+=50,v+=9)
+        {
+            std::memcpy(v,tri+12,9*sizeof(float));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+            for(int j=0;j<9;j++)
+            {
+                quint32 b = qFromLittleEndian<quint32>(reinterpret_cast<uchar *>(&v[j]));
+                std::memcpy(&v[j],&b,4);
+            }
+#endif
+            *c++ = 3;
+            *c++ = 3*i;
+            *c++ = 3*i+1;
+            *c++ = 3*i+2;
+        }
+    }
+
+    //a binary file is one solid, the header often starts with its name
+    std::string header(reinterpret_cast<const char *>(data),80);
+    header = header.substr(0,header.find('\0'));
+    std::string name;
+    if(header.compare(0,6,"solid ") == 0)
+    {
+        std::istringstream is(header.substr(6));
+        is >> name;
+    }
+    solidNames.push_back(solidName(name,0));
+
+    regions->SetNumberOfValues(n);
+    for(vtkIdType i=0;i<n;i++)
+        regions->SetValue(i,0);
+    return true;
+}
+
+bool HexSTLReader::readAscii(const char *data, qint64 size, HexSTLPoints &points,
+                             vtkIdTypeArray *conn, vtkIntArray *regions)
+{
+    const char *p = data;
+    const char *end = data+size;
+    const char *tok;
+    int len;
+    int region = -1;
+    std::vector<vtkIdType> loop;
+
+    while(nextToken(p,end,tok,len))
+    {
+        if(tokenIs(tok,len,"solid"))
+        {
+            //the name is the rest of the line
+            while(p < end && (*p == ' ' || *p == '\t'))
+                p++;
+            const char *name = p;
+            while(p < end && *p != '\n' && *p != '\r')
+                p++;
+            const char *nameEnd = p;
+            while(nameEnd > name && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t'))
+                nameEnd--;
+            region++;
+            solidNames.push_back(solidName(std::string(name,nameEnd),region));
+        }
+        else if(tokenIs(tok,len,"vertex"))
+        {
+            float v[3];
+            for(int i=0;i<3;i++)
+            {
+                bool ok = false;
+                if(nextToken(p,end,tok,len))
+                    v[i] = QByteArray::fromRawData(tok,len).toFloat(&ok);
+                if(!ok)
+                    return false;
+            }
+            loop.push_back(points.add(v));
+        }
+        else if(tokenIs(tok,len,"endloop"))
+        {
+            //facets with more than three vertices are split in triangles
+            if(region < 0)
+            {
+                region = 0;
+                solidNames.push_back(solidName("",0));
+            }
+            for(size_t i=1;i+1<loop.size();i++)
+            {
+                conn->InsertNextValue(3);
+                conn->InsertNextValue(loop[0]);
+                conn->InsertNextValue(loop[i]);
+                conn->InsertNextValue(loop[i+1]);
+                regions->InsertNextValue(region);
+            }
+            loop.clear();
+        }
+    }
+    return !solidNames.empty();
+}
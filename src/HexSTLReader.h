@@ -0,0 +1,103 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Reads ASCII and binary STL files, used in place of vtkSTLReader and
+    set up the same way (SetFileName, SetMerging). The file is memory
+    mapped and the points and triangles are written straight into the
+    arrays of the output, a binary file without merging is copied in one
+    pass. Each solid of an ASCII file gets a region id, stored as the
+    cell data "regionIds", and its name is kept (GetSolidName). Merging
+    of points is off by default; when on, equal points are found with a
+    hash table as they are read. MergePoints does the same for the
+    output of an earlier read.
+*/
+
+#ifndef HEXSTLREADER_H
+#define HEXSTLREADER_H
+
+#include <vtkPolyDataAlgorithm.h>
+#include <QtGlobal>
+#include <string>
+#include <vector>
+
+class vtkFloatArray;
+class vtkIdTypeArray;
+class vtkIntArray;
+class HexSTLPoints;
+
+class HexSTLReader : public vtkPolyDataAlgorithm
+{
+    vtkTypeMacro(HexSTLReader,vtkPolyDataAlgorithm)
+
+protected:
+    HexSTLReader();
+    ~HexSTLReader();
+    HexSTLReader(const HexSTLReader&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexSTLReader&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexSTLReader *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the file to read
+    vtkSetStringMacro(FileName)
+    vtkGetStringMacro(FileName)
+
+    //merge equal points, off by default
+    vtkSetMacro(Merging,int)
+    vtkGetMacro(Merging,int)
+    vtkBooleanMacro(Merging,int)
+
+    //solids of the last file read, region id i is solid i
+    int GetNumberOfSolids();
+    const char * GetSolidName(int i);
+
+    //copies the triangles of input, read without merging, to output
+    //with equal points merged. Used for feature edges, which need the
+    //shared point ids, without reading the file again.
+    static void MergePoints(vtkPolyData *input, vtkPolyData *output);
+
+protected:
+    int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+
+private:
+    //FUNCTIONS
+    //true if the size matches the triangle count of a binary file, or
+    //covers it and the header does not start like an ASCII file
+    bool isBinary(const unsigned char *data, qint64 size);
+    bool readBinary(const unsigned char *data, qint64 size, HexSTLPoints &points,
+                    vtkIdTypeArray *conn, vtkIntArray *regions);
+    bool readAscii(const char *data, qint64 size, HexSTLPoints &points,
+                   vtkIdTypeArray *conn, vtkIntArray *regions);
+
+    //DATA
+    char *FileName;
+    int Merging;
+    std::vector<std::string> solidNames;
+};
+
+#endif // HEXSTLREADER_H
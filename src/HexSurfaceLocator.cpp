@@ -0,0 +1,541 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexSurfaceLocator.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkPolyData.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkFloatArray.h>
+#include <vtkMultiThreader.h>
+#include <vtkMutexLock.h>
+#include <vtkMatrix4x4.h>
+
+#include <QThread>
+#include <algorithm>
+
+//triangles per leaf of the hierarchy
+static const vtkIdType leafSize = 4;
+//points taken by a thread at a time in findClosestPoints
+static const vtkIdType chunkSize = 64;
+
+//builds the hierarchy in run(), i.e. on its own thread
+class HexSurfaceLocatorBuilder : public QThread
+{
+public:
+    HexSurfaceLocatorBuilder(HexSurfaceLocator *loc) : locator(loc) {}
+protected:
+    void run()
+    {
+        locator->buildTree();
+    }
+private:
+    HexSurfaceLocator *locator;
+};
+
+//shared by the threads of findClosestPoints
+struct HexSurfaceQuery
+{
+    const HexSurfaceLocator *locator;
+    const double *pos;
+    double *closest;
+    vtkIdType n;
+    vtkIdType next; //first point not yet taken by a thread
+    bool cancelled;
+    HexSurfaceLocator::ProgressCallback progress;
+    void *clientData;
+    vtkSimpleMutexLock lock;
+
+    static VTK_THREAD_RETURN_TYPE run(void *arg);
+};
+
+VTK_THREAD_RETURN_TYPE HexSurfaceQuery::run(void *arg)
+{
+    vtkMultiThreader::ThreadInfo *info = static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+    HexSurfaceQuery *q = static_cast<HexSurfaceQuery *>(info->UserData);
+    while(true)
+    {
+        q->lock.Lock();
+        vtkIdType first = q->next;
+        bool stop = q->cancelled || first >= q->n;
+        q->next = std::min(first+chunkSize,q->n);
+        q->lock.Unlock();
+        if(stop)
+            break;
+
+        //each point is written by one thread only
+        vtkIdType last = std::min(first+chunkSize,q->n);
+        for(vtkIdType i=first;i<last;i++)
+            q->locator->closestPoint(&q->pos[3*i],&q->closest[3*i]);
+
+        //thread 0 is the calling thread, so the callback can use the GUI
+        if(info->ThreadID == 0 && q->progress != NULL &&
+                !q->progress(double(last)/q->n,q->clientData))
+        {
+            q->lock.Lock();
+            q->cancelled = true;
+            q->lock.Unlock();
+        }
+    }
+    return VTK_THREAD_RETURN_VALUE;
+}
+
+//q = m*p for a point, m is a 4x4 row major affine matrix
+static void transformPoint(const double m[16], const double p[3], double q[3])
+{
+    for(int i=0;i<3;i++)
+        q[i] = m[4*i]*p[0] + m[4*i+1]*p[1] + m[4*i+2]*p[2] + m[4*i+3];
+}
+
+//orders triangles by their centroid along an axis
+struct HexCentroidLess
+{
+    const std::vector<double> &centroids;
+    int axis;
+    HexCentroidLess(const std::vector<double> &c, int a) : centroids(c), axis(a) {}
+    bool operator()(vtkIdType a, vtkIdType b) const
+    {
+        return centroids[3*a+axis] < centroids[3*b+axis];
+    }
+};
+
+//squared distance from p to a box, 0 inside
+static double boxDistance2(const double b[6], const double p[3])
+{
+    double d2 = 0.0;
+    for(int i=0;i<3;i++)
+    {
+        double d = 0.0;
+        if(p[i] < b[2*i])
+            d = b[2*i]-p[i];
+        else if(p[i] > b[2*i+1])
+            d = p[i]-b[2*i+1];
+        d2 += d*d;
+    }
+    return d2;
+}
+
+static inline double dot(const double u[3], const double v[3])
+{
+    return u[0]*v[0]+u[1]*v[1]+u[2]*v[2];
+}
+
+//closest point q on the triangle (a,b,c) to p, see Ericson,
+//Real-Time Collision Detection, 5.1.5
+static void closestOnTriangle(const double p[3], const double a[3],
+                              const double b[3], const double c[3], double q[3])
+{
+    double ab[3],ac[3],ap[3],bp[3],cp[3];
+    for(int i=0;i<3;i++)
+    {
+        ab[i]=b[i]-a[i];
+        ac[i]=c[i]-a[i];
+        ap[i]=p[i]-a[i];
+        bp[i]=p[i]-b[i];
+        cp[i]=p[i]-c[i];
+    }
+    double d1=dot(ab,ap), d2=dot(ac,ap);
+    if(d1 <= 0.0 && d2 <= 0.0)
+    {
+        q[0]=a[0]; q[1]=a[1]; q[2]=a[2];
+        return;
+    }
+    double d3=dot(ab,bp), d4=dot(ac,bp);
+    if(d3 >= 0.0 && d4 <= d3)
+    {
+        q[0]=b[0]; q[1]=b[1]; q[2]=b[2];
+        return;
+    }
+    double d5=dot(ab,cp), d6=dot(ac,cp);
+    if(d6 >= 0.0 && d5 <= d6)
+    {
+        q[0]=c[0]; q[1]=c[1]; q[2]=c[2];
+        return;
+    }
+
+    double vc=d1*d4-d3*d2;
+    if(vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+        //on ab
+        double v=d1/(d1-d3);
+        for(int i=0;i<3;i++) q[i]=a[i]+v*ab[i];
+        return;
+    }
+    double vb=d5*d2-d1*d6;
+    if(vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+        //on ac
+        double w=d2/(d2-d6);
+        for(int i=0;i<3;i++) q[i]=a[i]+w*ac[i];
+        return;
+    }
+    double va=d3*d6-d5*d4;
+    if(va <= 0.0 && (d4-d3) >= 0.0 && (d5-d6) >= 0.0)
+    {
+        //on bc
+        double w=(d4-d3)/((d4-d3)+(d5-d6));
+        for(int i=0;i<3;i++) q[i]=b[i]+w*(c[i]-b[i]);
+        return;
+    }
+
+    //inside
+    double denom=1.0/(va+vb+vc);
+    double v=vb*denom;
+    double w=vc*denom;
+    for(int i=0;i<3;i++) q[i]=a[i]+ab[i]*v+ac[i]*w;
+}
+
+vtkStandardNewMacro(HexSurfaceLocator);
+
+HexSurfaceLocator::HexSurfaceLocator()
+{
+    points = NULL;
+    builder = new HexSurfaceLocatorBuilder(this);
+    vtkMatrix4x4::Identity(matrix);
+    vtkMatrix4x4::Identity(inverse);
+}
+
+HexSurfaceLocator::~HexSurfaceLocator()
+{
+    builder->wait();
+    delete builder;
+}
+
+void HexSurfaceLocator::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "cells: "
+       << (surface == NULL ? 0 : surface->GetNumberOfCells())
+       << ", built: " << isBuilt() << std::endl;
+}
+
+void HexSurfaceLocator::setSurface(vtkPolyData *surf)
+{
+    //the old hierarchy can't be changed while it's being built
+    builder->wait();
+
+    //a copy of our own, so the surface stays even if the reader
+    //updates its output. The build only reads it.
+    surface = vtkSmartPointer<vtkPolyData>::New();
+    surface->ShallowCopy(surf);
+
+    builder->start();
+    this->Modified();
+}
+
+bool HexSurfaceLocator::hasSurface()
+{
+    return surface != NULL && surface->GetNumberOfCells() > 0;
+}
+
+void HexSurfaceLocator::setTransform(vtkMatrix4x4 *m)
+{
+    vtkMatrix4x4::DeepCopy(matrix,m);
+    vtkMatrix4x4::Invert(matrix,inverse);
+}
+
+void HexSurfaceLocator::wait()
+{
+    builder->wait();
+}
+
+bool HexSurfaceLocator::isEmpty()
+{
+    if(!hasSurface())
+        return true;
+    builder->wait();
+    return nodes.empty();
+}
+
+bool HexSurfaceLocator::isBuilt()
+{
+    return hasSurface() && builder->isFinished();
+}
+
+void HexSurfaceLocator::buildTree()
+{
+    pointData = NULL;
+    points = NULL;
+    tris.clear();
+    nodes.clear();
+    if(surface->GetPoints() == NULL)
+        return;
+
+    //the points of HexSTLReader are floats and are searched as they
+    //are, other surfaces are converted once
+    vtkDataArray *data = surface->GetPoints()->GetData();
+    pointData = vtkFloatArray::SafeDownCast(data);
+    if(pointData == NULL)
+    {
+        pointData = vtkSmartPointer<vtkFloatArray>::New();
+        pointData->DeepCopy(data);
+    }
+    points = pointData->GetPointer(0);
+
+    //read through the arrays, traversing the cells would change the
+    //cell array that is also used to draw the geometry.
+    //Polygons are split in triangle fans, line segments, e.g. feature
+    //edges, are triangles with two equal corners so the same search
+    //finds the closest point on a curve.
+    vtkCellArray *polys = surface->GetPolys();
+    vtkIdType polySize = polys->GetNumberOfConnectivityEntries();
+    const vtkIdType *polyConn = polys->GetPointer();
+    vtkCellArray *lines = surface->GetLines();
+    vtkIdType lineSize = lines->GetNumberOfConnectivityEntries();
+    const vtkIdType *lineConn = lines->GetPointer();
+
+    //count first so tris is allocated once
+    vtkIdType numTris = 0;
+    for(vtkIdType k=0;k<polySize;k+=polyConn[k]+1)
+        numTris += std::max(polyConn[k]-2,vtkIdType(0));
+    for(vtkIdType k=0;k<lineSize;k+=lineConn[k]+1)
+        numTris += std::max(lineConn[k]-1,vtkIdType(0));
+    if(numTris == 0)
+        return;
+    tris.reserve(3*numTris);
+
+    for(vtkIdType k=0;k<polySize;k+=polyConn[k]+1)
+    {
+        for(vtkIdType j=1;j+1<polyConn[k];j++)
+        {
+            tris.push_back(polyConn[k+1]);
+            tris.push_back(polyConn[k+1+j]);
+            tris.push_back(polyConn[k+2+j]);
+        }
+    }
+    for(vtkIdType k=0;k<lineSize;k+=lineConn[k]+1)
+    {
+        for(vtkIdType j=1;j<lineConn[k];j++)
+        {
+            tris.push_back(lineConn[k+j]);
+            tris.push_back(lineConn[k+j+1]);
+            tris.push_back(lineConn[k+j+1]);
+        }
+    }
+
+    std::vector<vtkIdType> order(numTris);
+    std::vector<double> centroids(3*numTris);
+    for(vtkIdType t=0;t<numTris;t++)
+    {
+        order[t] = t;
+        for(int i=0;i<3;i++)
+            centroids[3*t+i] = (double(points[3*tris[3*t]+i]) +
+                                points[3*tris[3*t+1]+i] +
+                                points[3*tris[3*t+2]+i])/3.0;
+    }
+
+    nodes.reserve(2*(numTris/leafSize+1));
+    nodes.push_back(Node());
+    buildNode(0,0,numTris,order,centroids);
+    std::vector<double>().swap(centroids);
+
+    //store the triangles in leaf order, tris[t] = old tris[order[t]].
+    //The permutation is followed cycle by cycle in place, order[t]=t
+    //marks a triangle as done.
+    for(vtkIdType s=0;s<numTris;s++)
+    {
+        if(order[s] == s)
+            continue;
+        vtkIdType first[3] = {tris[3*s],tris[3*s+1],tris[3*s+2]};
+        vtkIdType t = s;
+        while(order[t] != s)
+        {
+            vtkIdType next = order[t];
+            for(int i=0;i<3;i++)
+                tris[3*t+i] = tris[3*next+i];
+            order[t] = t;
+            t = next;
+        }
+        for(int i=0;i<3;i++)
+            tris[3*t+i] = first[i];
+        order[t] = t;
+    }
+}
+
+void HexSurfaceLocator::buildNode(vtkIdType node, vtkIdType first, vtkIdType last,
+                                  std::vector<vtkIdType> &order,
+                                  const std::vector<double> &centroids)
+{
+    //bounds of the triangles and of their centroids
+    double b[6] = {VTK_DOUBLE_MAX,-VTK_DOUBLE_MAX,VTK_DOUBLE_MAX,
+                   -VTK_DOUBLE_MAX,VTK_DOUBLE_MAX,-VTK_DOUBLE_MAX};
+    double cb[6] = {VTK_DOUBLE_MAX,-VTK_DOUBLE_MAX,VTK_DOUBLE_MAX,
+                    -VTK_DOUBLE_MAX,VTK_DOUBLE_MAX,-VTK_DOUBLE_MAX};
+    for(vtkIdType t=first;t<last;t++)
+    {
+        for(int i=0;i<3;i++)
+        {
+            for(int j=0;j<3;j++)
+            {
+                double x = points[3*tris[3*order[t]+j]+i];
+                b[2*i] = std::min(b[2*i],x);
+                b[2*i+1] = std::max(b[2*i+1],x);
+            }
+            double c = centroids[3*order[t]+i];
+            cb[2*i] = std::min(cb[2*i],c);
+            cb[2*i+1] = std::max(cb[2*i+1],c);
+        }
+    }
+    std::copy(b,b+6,nodes[node].bounds);
+
+    if(last-first <= leafSize)
+    {
+        nodes[node].first = first;
+        nodes[node].count = last-first;
+        nodes[node].child = -1;
+        return;
+    }
+
+    //split at the median along the longest side
+    int axis = 0;
+    for(int i=1;i<3;i++)
+        if(cb[2*i+1]-cb[2*i] > cb[2*axis+1]-cb[2*axis])
+            axis = i;
+    vtkIdType mid = (first+last)/2;
+    std::nth_element(order.begin()+first,order.begin()+mid,order.begin()+last,
+                     HexCentroidLess(centroids,axis));
+
+    //nodes may move when pushing, so no references across this
+    vtkIdType child = nodes.size();
+    nodes.push_back(Node());
+    nodes.push_back(Node());
+    nodes[node].first = first;
+    nodes[node].count = 0;
+    nodes[node].child = child;
+    buildNode(child,first,mid,order,centroids);
+    buildNode(child+1,mid,last,order,centroids);
+}
+
+void HexSurfaceLocator::closestPoint(const double p[3], double closest[3]) const
+{
+    double best = VTK_DOUBLE_MAX;
+    closest[0] = p[0];
+    closest[1] = p[1];
+    closest[2] = p[2];
+
+    //the nearest child is searched first, it's on top of the stack
+    vtkIdType stack[128];
+    int top = 0;
+    stack[top++] = 0;
+    while(top > 0)
+    {
+        const Node &n = nodes[stack[--top]];
+        if(boxDistance2(n.bounds,p) >= best)
+            continue;
+
+        if(n.count > 0)
+        {
+            for(vtkIdType t=n.first;t<n.first+n.count;t++)
+            {
+                double a[3],b[3],c[3],q[3];
+                for(int i=0;i<3;i++)
+                {
+                    a[i] = points[3*tris[3*t]+i];
+                    b[i] = points[3*tris[3*t+1]+i];
+                    c[i] = points[3*tris[3*t+2]+i];
+                }
+                closestOnTriangle(p,a,b,c,q);
+                double d2 = (q[0]-p[0])*(q[0]-p[0]) + (q[1]-p[1])*(q[1]-p[1]) +
+                        (q[2]-p[2])*(q[2]-p[2]);
+                if(d2 < best)
+                {
+                    best = d2;
+                    closest[0] = q[0];
+                    closest[1] = q[1];
+                    closest[2] = q[2];
+                }
+            }
+            continue;
+        }
+
+        double d0 = boxDistance2(nodes[n.child].bounds,p);
+        double d1 = boxDistance2(nodes[n.child+1].bounds,p);
+        vtkIdType nearChild = d0 <= d1 ? n.child : n.child+1;
+        vtkIdType farChild = d0 <= d1 ? n.child+1 : n.child;
+        if(std::max(d0,d1) < best)
+            stack[top++] = farChild;
+        if(std::min(d0,d1) < best)
+            stack[top++] = nearChild;
+    }
+}
+
+bool HexSurfaceLocator::findClosestPoint(const double pos[3], double closest[3])
+{
+    //no threads or buffers for a single point, it's used while dragging
+    if(!hasSurface())
+        return false;
+    builder->wait();
+    if(nodes.empty())
+        return false;
+
+    double local[3],found[3];
+    transformPoint(inverse,pos,local);
+    closestPoint(local,found);
+    transformPoint(matrix,found,closest);
+    return true;
+}
+
+bool HexSurfaceLocator::findClosestPoints(vtkIdType n, const double *pos, double *closest,
+                                          ProgressCallback progress, void *clientData)
+{
+    if(!hasSurface())
+        return false;
+    builder->wait();
+    if(nodes.empty())
+        return false;
+    if(n <= 0)
+        return true;
+
+    //the hierarchy is in the coordinates of the surface
+    std::vector<double> local(3*n);
+    for(vtkIdType i=0;i<n;i++)
+        transformPoint(inverse,&pos[3*i],&local[3*i]);
+
+    HexSurfaceQuery q;
+    q.locator = this;
+    q.pos = &local[0];
+    q.closest = closest;
+    q.n = n;
+    q.next = 0;
+    q.cancelled = false;
+    q.progress = progress;
+    q.clientData = clientData;
+
+    vtkSmartPointer<vtkMultiThreader> threader = vtkSmartPointer<vtkMultiThreader>::New();
+    //no more threads than chunks
+    vtkIdType numChunks = (n+chunkSize-1)/chunkSize;
+    if(numChunks < threader->GetNumberOfThreads())
+        threader->SetNumberOfThreads(int(numChunks));
+    threader->SetSingleMethod(HexSurfaceQuery::run,&q);
+    threader->SingleMethodExecute();
+
+    for(vtkIdType i=0;i<n;i++)
+    {
+        double p[3] = {closest[3*i],closest[3*i+1],closest[3*i+2]};
+        transformPoint(matrix,p,&closest[3*i]);
+    }
+    return !q.cancelled;
+}
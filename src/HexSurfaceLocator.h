@@ -0,0 +1,138 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Finds the closest point on the geometry (STL surface), e.g. for
+    snapping vertices. The triangles of the surface, and its line
+    segments as triangles with two equal corners, are put in a
+    bounding volume hierarchy once for each surface that is set, on a
+    background thread, so reading a large geometry doesn't wait for it;
+    queries wait until the build is done. The hierarchy is only read
+    by queries, so many points can be searched at once on all cores
+    by findClosestPoints. The geometry may be drawn transformed (see
+    HexGeometry), the transform is applied to the query and the result
+    instead of the surface. It should only rotate, translate and scale
+    uniformly, otherwise the closest point is not preserved.
+*/
+
+#ifndef HEXSURFACELOCATOR_H
+#define HEXSURFACELOCATOR_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+
+class vtkPolyData;
+class vtkFloatArray;
+class vtkMatrix4x4;
+class HexSurfaceLocatorBuilder;
+struct HexSurfaceQuery;
+
+class HexSurfaceLocator : public vtkObject
+{
+    vtkTypeMacro(HexSurfaceLocator,vtkObject)
+
+    friend class HexSurfaceLocatorBuilder;
+    friend struct HexSurfaceQuery;
+
+protected:
+    HexSurfaceLocator();
+    ~HexSurfaceLocator();
+    HexSurfaceLocator(const HexSurfaceLocator&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexSurfaceLocator&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //called by findClosestPoints with the fraction of points done,
+    //return false to cancel. Always called from the calling thread.
+    typedef bool (*ProgressCallback)(double fraction, void *clientData);
+
+    //FUNCTIONS
+    static HexSurfaceLocator *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the surface to search, the locator is built in the background.
+    //the surface must not be changed afterwards, set a new one instead.
+    void setSurface(vtkPolyData *surf);
+    bool hasSurface();
+
+    //transform of the surface, positions are moved by the inverse
+    //before the search and the closest point by the transform.
+    //The matrix is copied, set it again when it changes.
+    void setTransform(vtkMatrix4x4 *m);
+
+    //true if there is nothing to search, i.e. no surface or one
+    //without polygons and lines. Waits for the locator.
+    bool isEmpty();
+
+    //waits for the locator to be built
+    void wait();
+    //true if the locator is built
+    bool isBuilt();
+
+    //the closest point on the surface to pos, false if there is
+    //no surface. Waits for the locator if it's being built.
+    //Cheap enough to be called for every mouse move.
+    bool findClosestPoint(const double pos[3], double closest[3]);
+
+    //as above for n points, pos and closest hold 3*n coordinates.
+    //The points are shared by all cores; the result is the same as
+    //point by point. False if the locator is empty or progress
+    //cancelled, closest is then incomplete; see isEmpty.
+    bool findClosestPoints(vtkIdType n, const double *pos, double *closest,
+                           ProgressCallback progress=NULL, void *clientData=NULL);
+
+private:
+    //a box of the hierarchy. Leafs have count triangles from first,
+    //other nodes have the children child and child+1.
+    struct Node
+    {
+        double bounds[6];
+        vtkIdType first;
+        vtkIdType count;
+        vtkIdType child;
+    };
+
+    //FUNCTIONS
+    //copies the triangles of surface and builds the hierarchy,
+    //run by the builder thread
+    void buildTree();
+    void buildNode(vtkIdType node, vtkIdType first, vtkIdType last,
+                   std::vector<vtkIdType> &order, const std::vector<double> &centroids);
+    //search of an unscaled point, only reads the hierarchy
+    void closestPoint(const double p[3], double closest[3]) const;
+
+    //DATA
+    vtkSmartPointer<vtkPolyData> surface;
+    HexSurfaceLocatorBuilder *builder;
+    double matrix[16];      //surface to model coordinates
+    double inverse[16];     //model to surface coordinates
+
+    vtkSmartPointer<vtkFloatArray> pointData; //the surface points
+    const float *points;            //x,y,z in pointData
+    std::vector<vtkIdType> tris;    //3 point ids per triangle, in node order
+    std::vector<Node> nodes;        //the root is nodes[0]
+};
+
+#endif // HEXSURFACELOCATOR_H
@@ -0,0 +1,615 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexUndoStack.h"
+#include "HexBlocker.h"
+#include "HexBlock.h"
+#include "HexEdge.h"
+#include "HexEdgeCollection.h"
+#include "HexPatch.h"
+#include "HexPatchCollection.h"
+#include "HexCollection.h"
+#include "HexIncidence.h"
+#include "HexBC.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+#include <algorithm>
+
+vtkStandardNewMacro(HexUndoStack);
+
+HexUndoStack::HexUndoStack()
+{
+    hexBlocker = NULL;
+    maxSteps = 50;
+    depth = 0;
+    isReplaying = false;
+    nextSerial = 0;
+}
+
+HexUndoStack::~HexUndoStack()
+{
+
+}
+
+void HexUndoStack::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "undo: " << undoSteps.size()
+       << ", redo: " << redoSteps.size() << std::endl;
+}
+
+void HexUndoStack::setHexBlocker(HexBlocker *hb)
+{
+    hexBlocker = hb;
+    clear();
+}
+
+void HexUndoStack::setMaxSteps(int n)
+{
+    maxSteps = n > 0 ? n : 1;
+    while((int)undoSteps.size() > maxSteps)
+        undoSteps.pop_front();
+}
+
+void HexUndoStack::clear()
+{
+    undoSteps.clear();
+    redoSteps.clear();
+    serials.clear();
+    ids.clear();
+    nextSerial = 0;
+}
+
+void HexUndoStack::begin(const char *name)
+{
+    if(isReplaying || hexBlocker == NULL)
+        return;
+    if(depth++ > 0)
+        return;
+    syncSerials();
+    current = Step();
+    current.name = name;
+    current.firstSerial = nextSerial;
+    addedBlocks.clear();
+}
+
+void HexUndoStack::end()
+{
+    if(!isRecording())
+        return;
+    if(--depth > 0)
+        return;
+
+    //the added blocks are stored as they are at the end
+    for(size_t i=0;i<addedBlocks.size();i++)
+    {
+        if(hexBlocker->hexBlocks->IsItemPresent(addedBlocks[i]) == 0)
+            continue;
+        BlockState state;
+        snapshotBlock(addedBlocks[i],state);
+        current.addedBlocks.push_back(state);
+    }
+    addedBlocks.clear();
+    //blocks are restored in order of their index, so the blocks before
+    //each one are in place when it's inserted. Removed blocks have the
+    //index they had when the change began, see HexBlocker::removeHexBlocks.
+    std::sort(current.removedBlocks.begin(),current.removedBlocks.end(),lessIndex);
+    std::sort(current.addedBlocks.begin(),current.addedBlocks.end(),lessIndex);
+    for(size_t i=0;i<current.bcs.size();i++)
+        snapshotBCPatches(current.bcs[i].bc,current.bcs[i].newPatches);
+    for(size_t i=0;i<current.bcProps.size();i++)
+    {
+        BCProps &bp = current.bcProps[i];
+        snapshotBC(bp.bc,bp.newIndex,bp.newName,bp.newType);
+    }
+    for(size_t i=0;i<current.arcs.size();i++)
+    {
+        ArcProps &ap = current.arcs[i];
+        HexEdge *e = hexBlocker->edges->findEdge(idOf(ap.verts[0]),idOf(ap.verts[1]));
+        if(e != NULL)
+            snapshotArc(e,ap.newType,ap.newPoint);
+    }
+
+    if(current.moves.empty() && current.removedBlocks.empty()
+            && current.addedBlocks.empty() && current.edges.empty()
+            && current.bcs.empty() && current.bcProps.empty()
+            && current.arcs.empty())
+        return;
+
+    undoSteps.push_back(current);
+    current = Step();
+    redoSteps.clear();
+    while((int)undoSteps.size() > maxSteps)
+        undoSteps.pop_front();
+}
+
+bool HexUndoStack::isRecording()
+{
+    return !isReplaying && depth > 0;
+}
+
+void HexUndoStack::verticeMoved(vtkIdType id, const double oldPos[3], const double newPos[3])
+{
+    if(!isRecording())
+        return;
+    MovedVertice mv;
+    mv.vert = serialOf(id);
+    for(int k=0;k<3;k++)
+    {
+        mv.oldPos[k] = oldPos[k];
+        mv.newPos[k] = newPos[k];
+    }
+    current.moves.push_back(mv);
+}
+
+void HexUndoStack::blockRemoved(HexBlock *hb)
+{
+    if(!isRecording())
+        return;
+    //added and removed in the same change, forget it
+    for(size_t i=0;i<addedBlocks.size();i++)
+    {
+        if(addedBlocks[i] == hb)
+        {
+            addedBlocks.erase(addedBlocks.begin()+i);
+            return;
+        }
+    }
+    BlockState state;
+    snapshotBlock(hb,state);
+    current.removedBlocks.push_back(state);
+}
+
+void HexUndoStack::blockAdded(HexBlock *hb)
+{
+    if(!isRecording())
+        return;
+    addedBlocks.push_back(hb);
+}
+
+void HexUndoStack::edgeChanged(HexEdge *e, int oldNCells, double oldGrading)
+{
+    if(!isRecording())
+        return;
+    EdgeProps ep;
+    ep.verts[0] = serialOf(e->vertIds->GetId(0));
+    ep.verts[1] = serialOf(e->vertIds->GetId(1));
+    ep.oldNCells = oldNCells;
+    ep.oldGrading = oldGrading;
+    ep.newNCells = e->nCells;
+    ep.newGrading = e->grading;
+    current.edges.push_back(ep);
+}
+
+void HexUndoStack::bcChanged(HexBC *bc)
+{
+    if(!isRecording())
+        return;
+    //only the state before the first change is needed
+    for(size_t i=0;i<current.bcs.size();i++)
+        if(current.bcs[i].bc == bc)
+            return;
+    BCPatches bp;
+    bp.bc = bc;
+    snapshotBCPatches(bc,bp.oldPatches);
+    current.bcs.push_back(bp);
+}
+
+void HexUndoStack::bcEdited(HexBC *bc)
+{
+    if(!isRecording())
+        return;
+    for(size_t i=0;i<current.bcProps.size();i++)
+        if(current.bcProps[i].bc == bc)
+            return;
+    BCProps bp;
+    bp.bc = bc;
+    snapshotBC(bc,bp.oldIndex,bp.oldName,bp.oldType);
+    current.bcProps.push_back(bp);
+}
+
+void HexUndoStack::arcChanged(HexEdge *e)
+{
+    if(!isRecording())
+        return;
+    vtkIdType v0 = serialOf(e->vertIds->GetId(0));
+    vtkIdType v1 = serialOf(e->vertIds->GetId(1));
+    for(size_t i=0;i<current.arcs.size();i++)
+        if(current.arcs[i].verts[0] == v0 && current.arcs[i].verts[1] == v1)
+            return;
+    ArcProps ap;
+    ap.verts[0] = v0;
+    ap.verts[1] = v1;
+    snapshotArc(e,ap.oldType,ap.oldPoint);
+    current.arcs.push_back(ap);
+}
+
+void HexUndoStack::remapVertices(const std::vector<vtkIdType> &newIds)
+{
+    //make sure every old vertice has a serial
+    syncSerials();
+    std::vector<vtkIdType> newSerials;
+    ids.clear();
+    for(size_t i=0;i<newIds.size() && i<serials.size();i++)
+    {
+        if(newIds[i] < 0)
+            continue;
+        ids[serials[i]] = newSerials.size();
+        newSerials.push_back(serials[i]);
+    }
+    serials.swap(newSerials);
+}
+
+bool HexUndoStack::canUndo()
+{
+    return !undoSteps.empty();
+}
+
+bool HexUndoStack::canRedo()
+{
+    return !redoSteps.empty();
+}
+
+std::string HexUndoStack::undoName()
+{
+    if(undoSteps.empty())
+        return std::string();
+    return undoSteps.back().name;
+}
+
+std::string HexUndoStack::redoName()
+{
+    if(redoSteps.empty())
+        return std::string();
+    return redoSteps.back().name;
+}
+
+bool HexUndoStack::undo()
+{
+    if(undoSteps.empty() || depth > 0)
+        return false;
+    Step step = undoSteps.back();
+    undoSteps.pop_back();
+    isReplaying = true;
+
+    //everything backwards, but blocks in order of index
+    std::vector<vtkIdType> freedVerts;
+    for(size_t i=step.addedBlocks.size();i>0;i--)
+        removeBlock(step.addedBlocks[i-1],freedVerts);
+    for(size_t i=0;i<step.removedBlocks.size();i++)
+        restoreBlock(step.removedBlocks[i]);
+    for(size_t i=step.moves.size();i>0;i--)
+        moveVertice(step.moves[i-1].vert,step.moves[i-1].oldPos);
+    for(size_t i=step.edges.size();i>0;i--)
+        setEdgeProps(step.edges[i-1],true);
+    for(size_t i=step.arcs.size();i>0;i--)
+        setArcProps(step.arcs[i-1],true);
+    for(size_t i=step.bcProps.size();i>0;i--)
+        setBCProps(step.bcProps[i-1],true);
+    for(size_t i=step.bcs.size();i>0;i--)
+        setBCPatches(step.bcs[i-1].bc,step.bcs[i-1].oldPatches);
+    //vertices the change created are removed again
+    removeFreeVertices(freedVerts,step.firstSerial);
+
+    isReplaying = false;
+    redoSteps.push_back(step);
+    return true;
+}
+
+bool HexUndoStack::redo()
+{
+    if(redoSteps.empty() || depth > 0)
+        return false;
+    Step step = redoSteps.back();
+    redoSteps.pop_back();
+    isReplaying = true;
+
+    std::vector<vtkIdType> freedVerts;
+    for(size_t i=0;i<step.moves.size();i++)
+        moveVertice(step.moves[i].vert,step.moves[i].newPos);
+    for(size_t i=0;i<step.removedBlocks.size();i++)
+        removeBlock(step.removedBlocks[i],freedVerts);
+    for(size_t i=0;i<step.addedBlocks.size();i++)
+        restoreBlock(step.addedBlocks[i]);
+    for(size_t i=0;i<step.edges.size();i++)
+        setEdgeProps(step.edges[i],false);
+    for(size_t i=0;i<step.arcs.size();i++)
+        setArcProps(step.arcs[i],false);
+    for(size_t i=0;i<step.bcs.size();i++)
+        setBCPatches(step.bcs[i].bc,step.bcs[i].newPatches);
+    for(size_t i=0;i<step.bcProps.size();i++)
+        setBCProps(step.bcProps[i],false);
+    //as when blocks are removed, unused vertices go too
+    removeFreeVertices(freedVerts,-1);
+
+    isReplaying = false;
+    undoSteps.push_back(step);
+    return true;
+}
+
+void HexUndoStack::snapshotBlock(HexBlock *hb, BlockState &state)
+{
+    state.index = hexBlocker->hexBlocks->IsItemPresent(hb)-1;
+    for(vtkIdType v=0;v<8;v++)
+    {
+        vtkIdType id = hb->vertIds->GetId(v);
+        state.verts[v] = serialOf(id);
+        hexBlocker->vertices->GetPoint(id,state.pos[v]);
+    }
+    for(vtkIdType k=0;k<12;k++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(hb->localEdges->GetItemAsObject(k));
+        state.nCells[k] = e->nCells;
+        state.grading[k] = e->grading;
+        snapshotArc(e,state.edgeTypes[k],state.cntrlPoints[k]);
+    }
+    for(vtkIdType p=0;p<hb->localPatches->GetNumberOfItems();p++)
+    {
+        HexPatch *patch = HexPatch::SafeDownCast(hb->localPatches->GetItemAsObject(p));
+        for(vtkIdType i=0;i<hexBlocker->hexBCs->GetNumberOfItems();i++)
+        {
+            HexBC *bc = HexBC::SafeDownCast(hexBlocker->hexBCs->GetItemAsObject(i));
+            if(bc->localPatches->IsItemPresent(patch))
+                state.bcs.push_back(std::make_pair(int(p),vtkSmartPointer<HexBC>(bc)));
+        }
+    }
+}
+
+void HexUndoStack::snapshotBCPatches(HexBC *bc, std::vector<vtkIdType> &patchVerts)
+{
+    patchVerts.clear();
+    for(vtkIdType i=0;i<bc->localPatches->GetNumberOfItems();i++)
+    {
+        HexPatch *p = HexPatch::SafeDownCast(bc->localPatches->GetItemAsObject(i));
+        for(vtkIdType k=0;k<4;k++)
+            patchVerts.push_back(serialOf(p->vertIds->GetId(k)));
+    }
+}
+
+HexBlock * HexUndoStack::findBlock(const BlockState &state)
+{
+    vtkIdType vIds[8];
+    for(int v=0;v<8;v++)
+    {
+        vIds[v] = idOf(state.verts[v]);
+        if(vIds[v] < 0)
+            return NULL;
+    }
+    const HexIncidence::BlockList &blocks =
+            hexBlocker->incidence->verticeBlocks(vIds[0]);
+    for(size_t i=0;i<blocks.size();i++)
+    {
+        bool same = true;
+        for(vtkIdType v=0;v<8 && same;v++)
+            same = blocks[i]->vertIds->GetId(v) == vIds[v];
+        if(same)
+            return blocks[i];
+    }
+    return NULL;
+}
+
+void HexUndoStack::restoreBlock(const BlockState &state)
+{
+    vtkSmartPointer<vtkIdList> vIds = vtkSmartPointer<vtkIdList>::New();
+    syncSerials();
+    for(int v=0;v<8;v++)
+    {
+        vtkIdType id = idOf(state.verts[v]);
+        if(id < 0)
+        {
+            //removed since, bring it back with its old serial
+            id = hexBlocker->vertices->InsertNextPoint(state.pos[v]);
+            serials.push_back(state.verts[v]);
+            ids[state.verts[v]] = id;
+        }
+        vIds->InsertNextId(id);
+    }
+    hexBlocker->vertices->Modified();
+    //the bounds are reset once by HexBlocker::undo
+    vtkSmartPointer<HexBlock> hb = hexBlocker->insertHexBlock(vIds);
+
+    //the block is added last, move it back to where it was
+    vtkIdType last = hexBlocker->hexBlocks->GetNumberOfItems()-1;
+    if(state.index >= 0 && state.index < last)
+    {
+        hexBlocker->hexBlocks->RemoveItem(last);
+        insertAt(hexBlocker->hexBlocks,hb,state.index);
+    }
+    for(vtkIdType k=0;k<12;k++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(hb->localEdges->GetItemAsObject(k));
+        e->nCells = state.nCells[k];
+        e->grading = state.grading[k];
+        if(state.edgeTypes[k] == HexEdge::ARC)
+        {
+            if(e->getType() != HexEdge::ARC)
+                e->setType(HexEdge::ARC);
+            e->setControlPoint(0,state.cntrlPoints[k]);
+            e->redrawedge();
+        }
+    }
+    for(size_t i=0;i<state.bcs.size();i++)
+    {
+        vtkObject *patch = hb->localPatches->GetItemAsObject(state.bcs[i].first);
+        HexBC *bc = state.bcs[i].second;
+        if(patch != NULL && !bc->localPatches->IsItemPresent(patch))
+            bc->localPatches->AddItem(patch);
+    }
+}
+
+void HexUndoStack::removeBlock(const BlockState &state, std::vector<vtkIdType> &freedVerts)
+{
+    HexBlock *hb = findBlock(state);
+    if(hb == NULL)
+    {
+        std::cout << "undo: could not find block to remove" << std::endl;
+        return;
+    }
+    vtkSmartPointer<vtkIdList> verts = vtkSmartPointer<vtkIdList>::New();
+    hexBlocker->removeHexBlock(hb,verts);
+    for(vtkIdType i=0;i<verts->GetNumberOfIds();i++)
+        freedVerts.push_back(verts->GetId(i));
+}
+
+void HexUndoStack::setBCPatches(HexBC *bc, const std::vector<vtkIdType> &patchVerts)
+{
+    bc->localPatches->RemoveAllItems();
+    for(size_t i=0;i+3<patchVerts.size();i+=4)
+    {
+        HexPatch *p = hexBlocker->patches->findPatch(
+                    idOf(patchVerts[i]),idOf(patchVerts[i+1]),
+                    idOf(patchVerts[i+2]),idOf(patchVerts[i+3]));
+        if(p != NULL)
+            bc->localPatches->AddItem(p);
+    }
+}
+
+void HexUndoStack::setEdgeProps(const EdgeProps &ep, bool useOld)
+{
+    HexEdge *e = hexBlocker->edges->findEdge(idOf(ep.verts[0]),idOf(ep.verts[1]));
+    if(e == NULL)
+        return;
+    e->nCells = useOld ? ep.oldNCells : ep.newNCells;
+    e->grading = useOld ? ep.oldGrading : ep.newGrading;
+}
+
+void HexUndoStack::snapshotBC(HexBC *bc, vtkIdType &index, std::string &name, std::string &type)
+{
+    index = hexBlocker->hexBCs->IsItemPresent(bc)-1;
+    name = bc->name;
+    type = bc->type;
+}
+
+void HexUndoStack::setBCProps(const BCProps &bp, bool useOld)
+{
+    vtkIdType index = useOld ? bp.oldIndex : bp.newIndex;
+    //bp holds a reference, so bc survives being taken out
+    if(hexBlocker->hexBCs->IsItemPresent(bp.bc))
+        hexBlocker->hexBCs->RemoveItem(bp.bc);
+    if(index >= 0)
+        insertAt(hexBlocker->hexBCs,bp.bc,index);
+    bp.bc->name = useOld ? bp.oldName : bp.newName;
+    bp.bc->type = useOld ? bp.oldType : bp.newType;
+}
+
+void HexUndoStack::snapshotArc(HexEdge *e, int &type, double point[3])
+{
+    type = e->getType();
+    point[0] = point[1] = point[2] = 0.0;
+    e->getControlPoint(0,point);
+}
+
+void HexUndoStack::setArcProps(const ArcProps &ap, bool useOld)
+{
+    HexEdge *e = hexBlocker->edges->findEdge(idOf(ap.verts[0]),idOf(ap.verts[1]));
+    if(e == NULL)
+        return;
+    int type = useOld ? ap.oldType : ap.newType;
+    //the end points may have been moved back, follow them first
+    e->redrawedge();
+    if(e->getType() != type)
+        e->setType(type == HexEdge::ARC ? HexEdge::ARC : HexEdge::LINE);
+    if(type == HexEdge::ARC)
+        e->setControlPoint(0,useOld ? ap.oldPoint : ap.newPoint);
+    e->redrawedge();
+}
+
+bool HexUndoStack::lessIndex(const BlockState &a, const BlockState &b)
+{
+    return a.index < b.index;
+}
+
+void HexUndoStack::insertAt(HexCollection *c, vtkObject *a, vtkIdType index)
+{
+    if(index >= c->GetNumberOfItems())
+        c->AddItem(a);
+    else
+        c->InsertItem(index-1,a);
+}
+
+void HexUndoStack::moveVertice(vtkIdType serial, const double pos[3])
+{
+    vtkIdType id = idOf(serial);
+    if(id < 0)
+        return;
+    double p[3] = {pos[0],pos[1],pos[2]};
+    hexBlocker->setVertice(id,p);
+}
+
+void HexUndoStack::removeFreeVertices(const std::vector<vtkIdType> &vIds, vtkIdType minSerial)
+{
+    vtkSmartPointer<vtkIdList> toRem = vtkSmartPointer<vtkIdList>::New();
+    for(size_t i=0;i<vIds.size();i++)
+    {
+        if(hexBlocker->isVerticeUsed(vIds[i]))
+            continue;
+        if(minSerial >= 0 && serialOf(vIds[i]) < minSerial)
+            continue;
+        toRem->InsertUniqueId(vIds[i]);
+    }
+    hexBlocker->removeVertices(toRem);
+}
+
+void HexUndoStack::syncSerials()
+{
+    vtkIdType n = hexBlocker->vertices->GetNumberOfPoints();
+    if(vtkIdType(serials.size()) > n)
+    {
+        //the vertices were replaced behind our back, start over
+        clear();
+    }
+    while(vtkIdType(serials.size()) < n)
+    {
+        ids[nextSerial] = serials.size();
+        serials.push_back(nextSerial++);
+    }
+}
+
+vtkIdType HexUndoStack::serialOf(vtkIdType id)
+{
+    syncSerials();
+    return serials[id];
+}
+
+vtkIdType HexUndoStack::idOf(vtkIdType serial)
+{
+    syncSerials();
+    std::map<vtkIdType,vtkIdType>::iterator it = ids.find(serial);
+    if(it == ids.end())
+        return -1;
+    return it->second;
+}
+
+HexUndoStep::HexUndoStep(HexUndoStack *s, const char *name)
+{
+    stack = s;
+    stack->begin(name);
+}
+
+HexUndoStep::~HexUndoStep()
+{
+    stack->end();
+}
@@ -0,0 +1,221 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Undo and redo of the changes HexBlocker makes to the model. Every
+    change is stored as a delta: the vertices that moved, the blocks
+    that were removed and added, the edges whose number of cells or
+    grading changed, the patches set on a BC, the BCs that were
+    created, renamed or removed and the type and control point of
+    arcs. Undo and redo replay the delta, so they cost as much as the
+    change and not the model. Blocks and BCs are put back at the
+    place in the list they were removed from.
+    Vertice ids are renumbered when vertices are removed, so the deltas
+    refer to vertices by a serial number that is never reused.
+    Only the last maxSteps changes are kept.
+*/
+
+#ifndef HEXUNDOSTACK_H
+#define HEXUNDOSTACK_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+
+class HexBlocker;
+class HexBlock;
+class HexEdge;
+class HexBC;
+class HexCollection;
+
+class HexUndoStack : public vtkObject
+{
+    vtkTypeMacro(HexUndoStack,vtkObject)
+
+protected:
+    HexUndoStack();
+    ~HexUndoStack();
+    HexUndoStack(const HexUndoStack&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexUndoStack&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexUndoStack *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    void setHexBlocker(HexBlocker *hb);
+    //the number of changes that can be undone
+    void setMaxSteps(int n);
+    //forgets all changes, e.g. when a new model is read
+    void clear();
+
+    //everything recorded between begin and end is one change.
+    //Nested calls belong to the outermost one.
+    void begin(const char *name);
+    void end();
+
+    //called by HexBlocker while a change is recorded
+    void verticeMoved(vtkIdType id, const double oldPos[3], const double newPos[3]);
+    //before the block is removed or its vertices are changed
+    void blockRemoved(HexBlock *hb);
+    //after the block is added or changed, it's stored at end()
+    void blockAdded(HexBlock *hb);
+    //after nCells and grading of e have been set
+    void edgeChanged(HexEdge *e, int oldNCells, double oldGrading);
+    //before the patches of bc are changed
+    void bcChanged(HexBC *bc);
+    //before bc is created, renamed or removed
+    void bcEdited(HexBC *bc);
+    //before the type or the control point of e is changed
+    void arcChanged(HexEdge *e);
+
+    //called by HexBlocker::compactVertices, newIds[old id] is
+    //the new id or -1 if the vertice was removed.
+    void remapVertices(const std::vector<vtkIdType> &newIds);
+
+    bool canUndo();
+    bool canRedo();
+    //name of the change to be undone/redone
+    std::string undoName();
+    std::string redoName();
+    //returns false if there was nothing to undo/redo
+    bool undo();
+    bool redo();
+
+private:
+    struct BlockState
+    {
+        vtkIdType index; //in the block list
+        vtkIdType verts[8]; //serials
+        double pos[8][3];
+        int nCells[12];
+        double grading[12];
+        int edgeTypes[12];
+        double cntrlPoints[12][3]; //of arcs
+        //local patch number and a BC it's in
+        std::vector<std::pair<int,vtkSmartPointer<HexBC> > > bcs;
+    };
+    struct MovedVertice
+    {
+        vtkIdType vert;
+        double oldPos[3];
+        double newPos[3];
+    };
+    struct EdgeProps
+    {
+        vtkIdType verts[2];
+        int oldNCells, newNCells;
+        double oldGrading, newGrading;
+    };
+    struct BCPatches
+    {
+        vtkSmartPointer<HexBC> bc;
+        //4 vertice serials for every patch
+        std::vector<vtkIdType> oldPatches, newPatches;
+    };
+    struct BCProps
+    {
+        vtkSmartPointer<HexBC> bc;
+        //in the BC list, -1 if not in it
+        vtkIdType oldIndex, newIndex;
+        std::string oldName, oldType, newName, newType;
+    };
+    struct ArcProps
+    {
+        vtkIdType verts[2];
+        int oldType, newType;
+        double oldPoint[3], newPoint[3];
+    };
+    struct Step
+    {
+        std::string name;
+        //vertices with a serial from here were created by the step
+        vtkIdType firstSerial;
+        std::vector<MovedVertice> moves;
+        std::vector<BlockState> removedBlocks;
+        std::vector<BlockState> addedBlocks;
+        std::vector<EdgeProps> edges;
+        std::vector<BCPatches> bcs;
+        std::vector<BCProps> bcProps;
+        std::vector<ArcProps> arcs;
+    };
+
+    bool isRecording();
+    void snapshotBlock(HexBlock *hb, BlockState &state);
+    void snapshotBCPatches(HexBC *bc, std::vector<vtkIdType> &patchVerts);
+    HexBlock * findBlock(const BlockState &state);
+    void restoreBlock(const BlockState &state);
+    void removeBlock(const BlockState &state, std::vector<vtkIdType> &freedVerts);
+    void setBCPatches(HexBC *bc, const std::vector<vtkIdType> &patchVerts);
+    void setEdgeProps(const EdgeProps &ep, bool useOld);
+    void snapshotBC(HexBC *bc, vtkIdType &index, std::string &name, std::string &type);
+    void setBCProps(const BCProps &bp, bool useOld);
+    void snapshotArc(HexEdge *e, int &type, double point[3]);
+    void setArcProps(const ArcProps &ap, bool useOld);
+    //orders blocks by their place in the block list
+    static bool lessIndex(const BlockState &a, const BlockState &b);
+    //puts a at index in c, or last if there are fewer items
+    static void insertAt(HexCollection *c, vtkObject *a, vtkIdType index);
+    void moveVertice(vtkIdType serial, const double pos[3]);
+    //removes the vertices in ids that no block uses and, if
+    //minSerial >= 0, that have a serial >= minSerial
+    void removeFreeVertices(const std::vector<vtkIdType> &ids, vtkIdType minSerial);
+
+    //serial numbers of vertices
+    void syncSerials();
+    vtkIdType serialOf(vtkIdType id);
+    //-1 if the vertice doesn't exist
+    vtkIdType idOf(vtkIdType serial);
+
+    //DATA
+    HexBlocker *hexBlocker;
+    int maxSteps;
+    int depth;
+    bool isReplaying;
+    Step current;
+    std::vector<vtkSmartPointer<HexBlock> > addedBlocks;
+    std::deque<Step> undoSteps;
+    std::vector<Step> redoSteps;
+
+    std::vector<vtkIdType> serials; //by vertice id
+    std::map<vtkIdType,vtkIdType> ids; //by serial
+    vtkIdType nextSerial;
+};
+
+//begins a change on construction and ends it when
+//going out of scope, also on an early return.
+class HexUndoStep
+{
+public:
+    HexUndoStep(HexUndoStack *s, const char *name);
+    ~HexUndoStep();
+private:
+    HexUndoStack *stack;
+};
+
+#endif // HEXUNDOSTACK_H
@@ -0,0 +1,103 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexVertIdsIndex.h"
+
+#include <vtkIdList.h>
+#include <algorithm>
+
+bool HexVertIdsIndex::Key::operator<(const Key &other) const
+{
+    for(int i=0;i<4;i++)
+    {
+        if(ids[i] != other.ids[i])
+            return ids[i] < other.ids[i];
+    }
+    return false;
+}
+
+HexVertIdsIndex::Key HexVertIdsIndex::makeKey(const vtkIdType *ids, int n)
+{
+    Key key;
+    n = std::min(n,4);
+    for(int i=0;i<4;i++)
+        key.ids[i] = i < n ? ids[i] : -1;
+    std::sort(key.ids,key.ids+4);
+    return key;
+}
+
+void HexVertIdsIndex::add(vtkObject *a, vtkIdList *ids)
+{
+    remove(a);
+    Key key = makeKey(ids->GetPointer(0),ids->GetNumberOfIds());
+    keys[a] = key;
+    //equal keys are kept in the order they are added
+    index.insert(Index::value_type(key,a));
+}
+
+void HexVertIdsIndex::remove(vtkObject *a)
+{
+    std::map<vtkObject *,Key>::iterator k = keys.find(a);
+    if(k == keys.end())
+        return;
+    std::pair<Index::iterator,Index::iterator> range = index.equal_range(k->second);
+    for(Index::iterator it=range.first;it!=range.second;++it)
+    {
+        if(it->second == a)
+        {
+            index.erase(it);
+            break;
+        }
+    }
+    keys.erase(k);
+}
+
+void HexVertIdsIndex::clear()
+{
+    index.clear();
+    keys.clear();
+}
+
+vtkObject * HexVertIdsIndex::find(const vtkIdType *ids, int n)
+{
+    //the first of equal keys is the first added
+    Key key = makeKey(ids,n);
+    Index::iterator it = index.lower_bound(key);
+    if(it == index.end() || key < it->first)
+        return NULL;
+    return it->second;
+}
+
+void HexVertIdsIndex::findAll(const vtkIdType *ids, int n, std::vector<vtkObject *> &found)
+{
+    std::pair<Index::iterator,Index::iterator> range = index.equal_range(makeKey(ids,n));
+    for(Index::iterator it=range.first;it!=range.second;++it)
+        found.push_back(it->second);
+}
+
+vtkIdType HexVertIdsIndex::size()
+{
+    return static_cast<vtkIdType>(keys.size());
+}
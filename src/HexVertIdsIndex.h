@@ -0,0 +1,78 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    The index shared by HexEdgeCollection and HexPatchCollection. It
+    maps the vertice ids of an item, sorted so their order doesn't
+    matter, to the items with those ids. It also remembers the key
+    each item was added with, so an item can be removed even after its
+    ids have changed. Items with the same ids are all kept and found in
+    the order they were added.
+*/
+
+#ifndef HEXVERTIDSINDEX_H
+#define HEXVERTIDSINDEX_H
+
+#include <vtkType.h>
+#include <map>
+#include <vector>
+
+class vtkObject;
+class vtkIdList;
+
+class HexVertIdsIndex
+{
+public:
+    //FUNCTIONS
+    //indexes a under the (at most 4) ids in ids, a is
+    //first removed if it's already indexed
+    void add(vtkObject *a, vtkIdList *ids);
+    void remove(vtkObject *a);
+    void clear();
+
+    //the first item added with the n ids, in any order, or NULL
+    vtkObject * find(const vtkIdType *ids, int n);
+    //appends all items with the n ids
+    void findAll(const vtkIdType *ids, int n, std::vector<vtkObject *> &found);
+
+    //number of indexed items
+    vtkIdType size();
+
+private:
+    //the ids sorted ascending, unused places are -1
+    struct Key
+    {
+        vtkIdType ids[4];
+        bool operator<(const Key &other) const;
+    };
+    typedef std::multimap<Key,vtkObject *> Index;
+
+    static Key makeKey(const vtkIdType *ids, int n);
+
+    //DATA
+    Index index;
+    std::map<vtkObject *,Key> keys; //the key each item was added with
+};
+
+#endif // HEXVERTIDSINDEX_H
@@ -0,0 +1,258 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexVertexLocator.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkPoints.h>
+#include <vtkMath.h>
+#include <vtkType.h>
+
+#include <algorithm>
+#include <cmath>
+
+vtkStandardNewMacro(HexVertexLocator);
+
+HexVertexLocator::HexVertexLocator()
+{
+    tolerance = 1e-6;
+    cellSize = 1.0;
+}
+
+HexVertexLocator::~HexVertexLocator()
+{
+
+}
+
+void HexVertexLocator::PrintSelf(ostream &os, vtkIndent indent)
+{
+    os << indent << "vertices: " << vertBucket.size()
+       << ", buckets: " << buckets.size()
+       << ", cell size: " << cellSize
+       << ", tolerance: " << tolerance << std::endl;
+}
+
+void HexVertexLocator::setPoints(vtkPoints *pts)
+{
+    points = pts;
+    buildLocator();
+}
+
+vtkPoints * HexVertexLocator::getPoints()
+{
+    return points;
+}
+
+void HexVertexLocator::setTolerance(double tol)
+{
+    tolerance = tol > 0 ? tol : 0.0;
+    buildLocator();
+}
+
+double HexVertexLocator::getTolerance()
+{
+    return tolerance;
+}
+
+void HexVertexLocator::buildLocator()
+{
+    buckets.clear();
+    vertBucket.clear();
+    if(points == NULL)
+        return;
+
+    vtkIdType n = points->GetNumberOfPoints();
+
+    //aim for about one vertice per cell, but never smaller than
+    //the tolerance since then we would have to search more cells.
+    cellSize = tolerance;
+    if(n > 0)
+    {
+        double b[6];
+        points->GetBounds(b);
+        double diag = sqrt((b[1]-b[0])*(b[1]-b[0])
+                + (b[3]-b[2])*(b[3]-b[2])
+                + (b[5]-b[4])*(b[5]-b[4]));
+        cellSize = std::max(cellSize, diag/pow(double(n),1.0/3.0));
+    }
+    if(cellSize <= 0)
+        cellSize = 1.0;
+
+    size_t nBuckets = 64;
+    while(nBuckets < size_t(n))
+        nBuckets *= 2;
+    buckets.resize(nBuckets);
+    vertBucket.reserve(n);
+
+    for(vtkIdType i=0;i<n;i++)
+        insertInBucket(i);
+}
+
+vtkIdType HexVertexLocator::findVertice(const double pos[3])
+{
+    syncPoints();
+    if(buckets.empty())
+        return -1;
+
+    vtkIdType cell[3];
+    cellOf(pos,cell);
+
+    vtkIdType found = -1;
+    double foundDist2 = tolerance*tolerance;
+    double vert[3];
+    //cells are at least as large as the tolerance, so the
+    //neighbouring cells are enough
+    for(vtkIdType i=-1;i<2;i++)
+    {
+        for(vtkIdType j=-1;j<2;j++)
+        {
+            for(vtkIdType k=-1;k<2;k++)
+            {
+                std::vector<vtkIdType> &bucket =
+                        buckets[bucketOf(cell[0]+i,cell[1]+j,cell[2]+k)];
+                for(size_t b=0;b<bucket.size();b++)
+                {
+                    points->GetPoint(bucket[b],vert);
+                    double dist2 = vtkMath::Distance2BetweenPoints(pos,vert);
+                    if(dist2 > foundDist2)
+                        continue;
+                    //closest wins, and the lowest id if equally close
+                    if(found < 0 || dist2 < foundDist2 || bucket[b] < found)
+                    {
+                        found = bucket[b];
+                        foundDist2 = dist2;
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
+vtkIdType HexVertexLocator::insertUniqueVertice(const double pos[3])
+{
+    vtkIdType id = findVertice(pos);
+    if(id > -1)
+        return id;
+    id = points->InsertNextPoint(pos);
+    insertInBucket(id);
+    return id;
+}
+
+void HexVertexLocator::updateVertice(vtkIdType id)
+{
+    syncPoints();
+    if(id < 0 || id >= vtkIdType(vertBucket.size()))
+        return;
+    removeFromBucket(id);
+    insertInBucket(id);
+}
+
+void HexVertexLocator::remapVertices(const std::vector<vtkIdType> &newIds)
+{
+    //vertices appended after the last sync are left to syncPoints
+    vtkIdType n = 0;
+    for(size_t i=0;i<newIds.size() && i<vertBucket.size();i++)
+        n = std::max(n,newIds[i]+1);
+
+    std::vector<vtkIdType> newBucket(n,-1);
+    for(size_t b=0;b<buckets.size();b++)
+    {
+        std::vector<vtkIdType> &bucket = buckets[b];
+        size_t w = 0;
+        for(size_t r=0;r<bucket.size();r++)
+        {
+            vtkIdType id = bucket[r];
+            if(id >= vtkIdType(newIds.size()) || newIds[id] < 0)
+                continue;
+            bucket[w++] = newIds[id];
+            newBucket[newIds[id]] = b;
+        }
+        bucket.resize(w);
+    }
+    vertBucket.swap(newBucket);
+}
+
+void HexVertexLocator::syncPoints()
+{
+    if(points == NULL)
+        return;
+    vtkIdType n = points->GetNumberOfPoints();
+    vtkIdType nIndexed = vertBucket.size();
+    //vertices have been removed, or there are many more than when the
+    //cell size was chosen
+    if(n < nIndexed || size_t(n) > 2*buckets.size())
+    {
+        buildLocator();
+        return;
+    }
+    for(vtkIdType i=nIndexed;i<n;i++)
+        insertInBucket(i);
+}
+
+vtkIdType HexVertexLocator::bucketOf(vtkIdType i, vtkIdType j, vtkIdType k)
+{
+    vtkTypeUInt64 h = static_cast<vtkTypeUInt64>(i)*73856093u
+            ^ static_cast<vtkTypeUInt64>(j)*19349663u
+            ^ static_cast<vtkTypeUInt64>(k)*83492791u;
+    return static_cast<vtkIdType>(h % buckets.size());
+}
+
+void HexVertexLocator::cellOf(const double pos[3], vtkIdType cell[3])
+{
+    for(int d=0;d<3;d++)
+    {
+        //clamp, far away vertices just end up in the same cells
+        double c = floor(pos[d]/cellSize);
+        c = std::max(-1e15,std::min(1e15,c));
+        cell[d] = static_cast<vtkIdType>(c);
+    }
+}
+
+void HexVertexLocator::insertInBucket(vtkIdType id)
+{
+    double pos[3];
+    vtkIdType cell[3];
+    points->GetPoint(id,pos);
+    cellOf(pos,cell);
+    vtkIdType b = bucketOf(cell[0],cell[1],cell[2]);
+    buckets[b].push_back(id);
+    if(id >= vtkIdType(vertBucket.size()))
+        vertBucket.resize(id+1,-1);
+    vertBucket[id] = b;
+}
+
+void HexVertexLocator::removeFromBucket(vtkIdType id)
+{
+    std::vector<vtkIdType> &bucket = buckets[vertBucket[id]];
+    std::vector<vtkIdType>::iterator it =
+            std::find(bucket.begin(),bucket.end(),id);
+    if(it != bucket.end())
+    {
+        *it = bucket.back();
+        bucket.pop_back();
+    }
+    vertBucket[id] = -1;
+}
@@ -0,0 +1,106 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Finds vertices by position. The global vertices are hashed into a
+    uniform grid with cells at least as large as the merge tolerance, so
+    looking for a vertex within the tolerance only has to check the
+    vertices in the 27 cells around it, instead of every vertex in the
+    model. Used when new vertices are created (extrude, split) so that
+    a vertex that already exists, or nearly exists, is reused.
+    The owner must call updateVertice when it moves a vertex and
+    remapVertices when vertices are removed; vertices appended to the
+    points by someone else are picked up automatically.
+*/
+
+#ifndef HEXVERTEXLOCATOR_H
+#define HEXVERTEXLOCATOR_H
+
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+
+class vtkPoints;
+
+class HexVertexLocator : public vtkObject
+{
+    vtkTypeMacro(HexVertexLocator,vtkObject)
+
+protected:
+    HexVertexLocator();
+    ~HexVertexLocator();
+    HexVertexLocator(const HexVertexLocator&);  // Not implemented in order to comply with vtkObject.
+    void operator=(const HexVertexLocator&);  // Not implemented in order to comply with vtkObject.
+
+public:
+    //FUNCTIONS
+    static HexVertexLocator *New();
+    // inorder to comply with vtkObect
+    void PrintSelf(ostream &os, vtkIndent indent);
+
+    //the vertices to search, rebuilds the locator
+    void setPoints(vtkPoints *pts);
+    vtkPoints * getPoints();
+
+    //vertices closer than tol are the same vertex, 0 means exactly equal.
+    //rebuilds the locator
+    void setTolerance(double tol);
+    double getTolerance();
+
+    //hash all vertices again
+    void buildLocator();
+
+    //returns the id of the closest vertice within the tolerance
+    //of pos or -1 if there is none.
+    vtkIdType findVertice(const double pos[3]);
+
+    //as above, but if there is none pos is inserted into the points
+    //and the new id is returned.
+    vtkIdType insertUniqueVertice(const double pos[3]);
+
+    //vertice id has been moved
+    void updateVertice(vtkIdType id);
+
+    //the points have been compacted, vertice i is now newIds[i] or
+    //-1 if it was removed. The remaining vertices keep their cells.
+    void remapVertices(const std::vector<vtkIdType> &newIds);
+
+private:
+    //index vertices that have been added to points since the last call
+    void syncPoints();
+    vtkIdType bucketOf(vtkIdType i, vtkIdType j, vtkIdType k);
+    void cellOf(const double pos[3], vtkIdType cell[3]);
+    void insertInBucket(vtkIdType id);
+    void removeFromBucket(vtkIdType id);
+
+    //DATA
+    vtkSmartPointer<vtkPoints> points;
+    double tolerance;
+    double cellSize;
+    std::vector<std::vector<vtkIdType> > buckets;
+    //bucket of each vertice, needed when a vertice is moved
+    std::vector<vtkIdType> vertBucket;
+};
+
+#endif // HEXVERTEXLOCATOR_H
@@ -0,0 +1,396 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+#include "HexView.h"
+#include "HexBlocker.h"
+#include "HexPatch.h"
+#include "HexPatchCollection.h"
+#include "HexEdge.h"
+#include "HexEdgeCollection.h"
+#include "HexCollection.h"
+#include "HexBlockRepresentation.h"
+#include "HexAxesRepresentation.h"
+#include "HexEdgeRepresentation.h"
+#include "HexPatchRepresentation.h"
+#include "HexLabelRepresentation.h"
+#include "HexGeometryRepresentation.h"
+#include "HexRenderScheduler.h"
+
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPointData.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkSphereSource.h>
+#include <vtkGlyph3DMapper.h>
+#include <vtkActor.h>
+#include <vtkAssembly.h>
+#include <vtkActor2D.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkCallbackCommand.h>
+#include <vtkCamera.h>
+#include <vtkMath.h>
+#include <vtkOrientationMarkerWidget.h>
+#include <vtkAxesActor.h>
+
+#include <set>
+#include <algorithm>
+#include <cmath>
+
+const double HexView::pickTolerance = 0.001;
+
+HexView::HexView(HexBlocker *hexb)
+{
+    hexBlocker = hexb;
+
+    vertSphere = vtkSmartPointer<vtkSphereSource>::New();
+    vertSphere->SetThetaResolution(10);
+    vertSphere->SetPhiResolution(10);
+
+    //one sphere drawn at every vertice, the spheres are not copied
+    //into a polydata so moving vertices only changes the points.
+    //removed vertices are masked out until they are compacted away
+    vertGlyphData = vtkSmartPointer<vtkPolyData>::New();
+    vtkSmartPointer<vtkUnsignedCharArray> mask = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    mask->SetName("visible");
+    vertGlyphData->GetPointData()->AddArray(mask);
+    vertMapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+#if VTK_MAJOR_VERSION <= 5
+    vertMapper->SetInputConnection(vertGlyphData->GetProducerPort());
+#else
+    vertMapper->SetInputData(vertGlyphData);
+#endif
+    vertMapper->SetSourceConnection(vertSphere->GetOutputPort());
+    vertMapper->ScalingOff();
+    vertMapper->SetMaskArray("visible");
+    vertMapper->MaskingOn();
+
+    vertActor = vtkSmartPointer<vtkActor>::New();
+    vertActor->SetMapper(vertMapper);
+
+    renderer = vtkSmartPointer<vtkRenderer>::New();
+    //all blocks, edges and patches are drawn by one actor each
+    blockRep = vtkSmartPointer<HexBlockRepresentation>::New();
+    axesRep = vtkSmartPointer<HexAxesRepresentation>::New();
+    edgeRep = vtkSmartPointer<HexEdgeRepresentation>::New();
+    patchRep = vtkSmartPointer<HexPatchRepresentation>::New();
+    geometryRep = vtkSmartPointer<HexGeometryRepresentation>::New();
+    geometryRep->setGeometries(hexBlocker->geometries);
+    bindModel();
+
+    //id labels, only the vertice ids are shown from start
+    vertLabels = vtkSmartPointer<HexLabelRepresentation>::New();
+    vertLabels->setHexBlocker(hexBlocker,HexLabelRepresentation::VERTICES);
+    vertLabels->setColor(1,0,0);
+    blockLabels = vtkSmartPointer<HexLabelRepresentation>::New();
+    blockLabels->setHexBlocker(hexBlocker,HexLabelRepresentation::BLOCKS);
+    blockLabels->setColor(0,0,0);
+    blockLabels->setVisibility(false);
+    patchLabels = vtkSmartPointer<HexLabelRepresentation>::New();
+    patchLabels->setHexBlocker(hexBlocker,HexLabelRepresentation::PATCHES);
+    patchLabels->setColor(0,0,1);
+    patchLabels->setVisibility(false);
+    edgeLabels = vtkSmartPointer<HexLabelRepresentation>::New();
+    edgeLabels->setHexBlocker(hexBlocker,HexLabelRepresentation::EDGES);
+    edgeLabels->setColor(0,0.5,0);
+    edgeLabels->setVisibility(false);
+
+    renderer->AddActor(vertActor);
+    renderer->AddActor(vertLabels->actor);
+    renderer->AddActor(blockLabels->actor);
+    renderer->AddActor(patchLabels->actor);
+    renderer->AddActor(edgeLabels->actor);
+    renderer->AddActor(blockRep->actor);
+    renderer->AddActor(axesRep->actor);
+    renderer->AddActor(edgeRep->actor);
+    renderer->AddActor(patchRep->actor);
+    renderer->AddActor(geometryRep->actor);
+
+    //bring the representations up to date before each render,
+    //also the ones started by the interactor
+    vtkSmartPointer<vtkCallbackCommand> startRender =
+            vtkSmartPointer<vtkCallbackCommand>::New();
+    startRender->SetCallback(HexView::updateRepresentations);
+    startRender->SetClientData(this);
+    renderer->AddObserver(vtkCommand::StartEvent,startRender);
+
+    vtkCamera * cam = renderer->GetActiveCamera();
+    cam->SetParallelProjection(1);
+    cam->SetFreezeFocalPoint(1);
+    isRendering=false;
+    renderScheduler = new HexRenderScheduler(this);
+
+    //vertice and edge sizes for the model as it is now
+    resetRadii();
+    hexBlocker->setRenderCallback(HexView::renderRequested,this);
+}
+
+HexView::~HexView()
+{
+    hexBlocker->setRenderCallback(NULL,NULL);
+    renderer->RemoveAllObservers();
+    delete renderScheduler;
+}
+
+void HexView::initOrientationAxes(vtkRenderWindow *renwin)
+{
+    // Axes interactor and widget
+    orientationAxes = vtkSmartPointer<vtkAxesActor>::New();
+    orientationAxesWidget = vtkSmartPointer<vtkOrientationMarkerWidget>::New();
+    orientationAxesWidget->SetViewport( 0.0, 0.0, 0.4, 0.4 );
+    orientationAxesWidget->SetOutlineColor( 0.9300, 0.5700, 0.1300 );
+    orientationAxesWidget->SetOrientationMarker( orientationAxes );
+    orientationAxesWidget->SetInteractor(renwin->GetInteractor());
+    orientationAxesWidget->SetEnabled(1);
+    orientationAxesWidget->InteractiveOff();
+}
+
+void HexView::removeOrientationAxes()
+{
+    if(orientationAxesWidget != NULL)
+        orientationAxesWidget->Off();
+}
+
+void HexView::showBlocks()
+{
+    visibilityBlocks(true);
+}
+
+void HexView::hideBlocks()
+{
+    visibilityBlocks(false);
+}
+
+void HexView::visibilityBlocks(bool mode)
+{
+    //the local axes are always shown
+    blockRep->actor->SetVisibility(mode);
+}
+
+void HexView::showPatches()
+{
+    visibilityPatches(true);
+}
+
+void HexView::hidePatches()
+{
+    visibilityPatches(false);
+}
+
+void HexView::visibilityPatches(bool mode)
+{
+    patchRep->actor->SetVisibility(mode);
+    HexPatchCollection *patches = hexBlocker->patches;
+    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
+    {
+        HexPatch *p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
+        p->resetColor();
+    }
+}
+
+void HexView::showEdges()
+{
+    visibilityEdges(true);
+}
+
+void HexView::hideEdges()
+{
+    visibilityEdges(false);
+}
+
+void HexView::visibilityEdges(bool mode)
+{
+    edgeRep->actor->SetVisibility(mode);
+}
+
+void HexView::showVertIDs()
+{
+    visibilityVertIDs(true);
+}
+
+void HexView::hideVertIDs()
+{
+    visibilityVertIDs(false);
+}
+
+void HexView::visibilityVertIDs(bool mode)
+{
+    vertLabels->setVisibility(mode);
+}
+
+void HexView::visibilityBlockIDs(bool mode)
+{
+    blockLabels->setVisibility(mode);
+}
+
+void HexView::visibilityPatchIDs(bool mode)
+{
+    patchLabels->setVisibility(mode);
+}
+
+void HexView::visibilityEdgeIDs(bool mode)
+{
+    edgeLabels->setVisibility(mode);
+}
+
+void HexView::render()
+{
+    //nothing to draw on until the renderer is in a window
+    if(renderer->GetRenderWindow() == NULL)
+        return;
+    renderScheduler->requestRender();
+}
+
+void HexView::renderNow()
+{
+    if(isRendering || renderer->GetRenderWindow() == NULL)
+        return;
+    isRendering=true;
+    renderer->GetRenderWindow()->Render();
+    isRendering=false;
+}
+
+void HexView::renderRequested(void *clientData)
+{
+    static_cast<HexView *>(clientData)->render();
+}
+
+void HexView::bindModel()
+{
+    if(vertGlyphData->GetPoints() != hexBlocker->vertices.GetPointer())
+        vertGlyphData->SetPoints(hexBlocker->vertices);
+    if(boundBlocks != hexBlocker->hexBlocks)
+    {
+        boundBlocks = hexBlocker->hexBlocks;
+        blockRep->setBlocks(hexBlocker->hexBlocks,hexBlocker->vertices);
+        axesRep->setBlocks(hexBlocker->hexBlocks,hexBlocker->vertices);
+    }
+    if(boundEdges != hexBlocker->edges)
+    {
+        boundEdges = hexBlocker->edges;
+        edgeRep->setEdges(hexBlocker->edges);
+    }
+    if(boundPatches != hexBlocker->patches)
+    {
+        boundPatches = hexBlocker->patches;
+        patchRep->setPatches(hexBlocker->patches,hexBlocker->vertices);
+    }
+}
+
+void HexView::updateVertMask()
+{
+    vtkUnsignedCharArray *mask = vtkUnsignedCharArray::SafeDownCast(
+                vertGlyphData->GetPointData()->GetArray("visible"));
+    vtkIdType n = hexBlocker->vertices->GetNumberOfPoints();
+    const std::set<vtkIdType> &removed = hexBlocker->getRemovedVertices();
+    //a removed vertice is shown again if a block uses it
+    if(mask->GetNumberOfTuples() == n &&
+            maskTime > hexBlocker->getRemovedVerticesMTime() &&
+            (removed.empty() || maskTime > hexBlocker->hexBlocks->GetMTime()))
+        return;
+
+    mask->SetNumberOfTuples(n);
+    unsigned char *m = mask->GetPointer(0);
+    std::fill(m,m+n,1);
+    std::set<vtkIdType>::const_iterator it;
+    for(it=removed.begin();it!=removed.end();++it)
+    {
+        if(*it < n && hexBlocker->isVerticeRemoved(*it))
+            m[*it] = 0;
+    }
+    mask->Modified();
+    vertGlyphData->Modified();
+    maskTime.Modified();
+}
+
+void HexView::resetRadii()
+{
+    HexEdgeCollection *edges = hexBlocker->edges;
+    double minLength=1e6;
+    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
+    {
+        HexEdge * e =
+                HexEdge::SafeDownCast(edges->GetItemAsObject(i));
+        double edgeLength=e->getLength();
+        minLength=fmin(minLength,edgeLength);
+    }
+
+    double vertRadius=minLength*0.02;
+    double edgeRadius=vertRadius*0.5;
+    vertSphere->SetRadius(vertRadius);
+    edgeRep->setRadius(edgeRadius);
+}
+
+void HexView::updateArcTolerance(vtkRenderer *ren)
+{
+    //The tolerance is rounded down to a power of two so zooming only
+    //redraws the arcs now and then.
+    if(ren == NULL || ren->GetSize()[1] <= 0)
+        return;
+    vtkCamera *cam = ren->GetActiveCamera();
+    double height; //of the view in model units
+    if(cam->GetParallelProjection())
+        height = 2.0*cam->GetParallelScale();
+    else
+        height = 2.0*cam->GetDistance()*
+                std::tan(vtkMath::RadiansFromDegrees(0.5*cam->GetViewAngle()));
+    double tol = 0.5*height/ren->GetSize()[1];
+    if(tol > 0.0)
+        edgeRep->setArcTolerance(
+                    std::pow(2.0,std::floor(std::log(tol)/std::log(2.0))));
+}
+
+void HexView::updateRepresentations(vtkObject *caller, unsigned long, void *clientData, void *)
+{
+    HexView *view = static_cast<HexView *>(clientData);
+    HexBlocker *hexBlocker = view->hexBlocker;
+    view->bindModel();
+    view->updateVertMask();
+
+    //HexBlocker::resetBounds has been called, the camera is fit below
+    //once everything is drawn
+    bool fit = hexBlocker->getBoundsMTime() > view->boundsTime;
+    if(fit)
+        view->resetRadii();
+
+    view->updateArcTolerance(vtkRenderer::SafeDownCast(caller));
+    view->blockRep->update();
+    view->axesRep->update();
+    view->edgeRep->update();
+    view->patchRep->update();
+    view->geometryRep->update();
+    view->vertLabels->update();
+    view->blockLabels->update();
+    view->patchLabels->update();
+    view->edgeLabels->update();
+
+    if(fit)
+    {
+        double bounds[6];
+        view->renderer->ComputeVisiblePropBounds(bounds);
+        view->renderer->ResetCamera(bounds);
+        view->boundsTime.Modified();
+    }
+}
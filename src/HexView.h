@@ -0,0 +1,153 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    The rendered view of a HexBlocker model. It owns the renderer and
+    everything drawn in it: the vertice glyphs, the representations of
+    the blocks, their local axes, the edges, the patches, the id labels
+    and the geometries, and the orientation axes. The model only asks
+    for a render through HexBlocker::render; the view collapses the
+    requests with a HexRenderScheduler and brings its representations up
+    to date with the model before each render. The model does not know
+    about the view, so it can be used without one, e.g. in batch runs.
+*/
+
+#ifndef HEXVIEW_H
+#define HEXVIEW_H
+
+#include <vtkSmartPointer.h>
+#include <vtkTimeStamp.h>
+
+class HexBlocker;
+class HexBlockRepresentation;
+class HexAxesRepresentation;
+class HexEdgeRepresentation;
+class HexPatchRepresentation;
+class HexLabelRepresentation;
+class HexGeometryRepresentation;
+class HexRenderScheduler;
+class HexCollection;
+class HexEdgeCollection;
+class HexPatchCollection;
+class vtkPolyData;
+class vtkSphereSource;
+class vtkGlyph3DMapper;
+class vtkActor;
+class vtkRenderer;
+class vtkRenderWindow;
+class vtkAxesActor;
+class vtkOrientationMarkerWidget;
+class vtkObject;
+
+class HexView
+{
+public:
+    //draws hexb, which must outlive the view
+    HexView(HexBlocker *hexb);
+    ~HexView();
+
+    //FUNCTIONS
+    //inits the global axes
+    void initOrientationAxes(vtkRenderWindow * renwin);
+    //removes the same
+    void removeOrientationAxes();
+
+    //show/hide objects
+    void showBlocks();
+    void hideBlocks();
+    void visibilityBlocks(bool mode);
+    void showPatches();
+    void hidePatches();
+    void visibilityPatches(bool mode);
+    void showEdges();
+    void hideEdges();
+    void visibilityEdges(bool mode);
+    void showVertIDs();
+    void hideVertIDs();
+    void visibilityVertIDs(bool mode);
+    void visibilityBlockIDs(bool mode);
+    void visibilityPatchIDs(bool mode);
+    void visibilityEdgeIDs(bool mode);
+
+    //request a render, all requests until control is back in the
+    //event loop give a single render, see HexRenderScheduler
+    void render();
+    //render at once
+    void renderNow();
+
+    //DATA
+    //tolerance of the cell pickers as a fraction of the window size,
+    //used by the interactor styles and the benchmarks
+    static const double pickTolerance;
+    HexBlocker *hexBlocker;
+    vtkSmartPointer<vtkSphereSource> vertSphere;
+    vtkSmartPointer<vtkGlyph3DMapper> vertMapper;
+    vtkSmartPointer<vtkActor> vertActor;
+    vtkSmartPointer<HexBlockRepresentation> blockRep; //all blocks
+    vtkSmartPointer<HexAxesRepresentation> axesRep; //local axes of all blocks
+    vtkSmartPointer<HexEdgeRepresentation> edgeRep; //all edges
+    vtkSmartPointer<HexPatchRepresentation> patchRep; //all patches
+    vtkSmartPointer<HexGeometryRepresentation> geometryRep; //all geometries
+    vtkSmartPointer<vtkAxesActor> orientationAxes;
+    vtkSmartPointer<vtkOrientationMarkerWidget> orientationAxesWidget;
+    vtkSmartPointer<HexLabelRepresentation> vertLabels; //id labels
+    vtkSmartPointer<HexLabelRepresentation> blockLabels;
+    vtkSmartPointer<HexLabelRepresentation> patchLabels;
+    vtkSmartPointer<HexLabelRepresentation> edgeLabels;
+    vtkSmartPointer<vtkRenderer> renderer;
+    HexRenderScheduler *renderScheduler; //collapses render requests
+
+private:
+    //FUNCTIONS
+    //called by the model after each change
+    static void renderRequested(void *clientData);
+    //called by the renderer before each render
+    static void updateRepresentations(vtkObject *caller, unsigned long eventId,
+                                      void *clientData, void *callData);
+
+    //points the representations at the lists of the model,
+    //readBlockMeshDict replaces them
+    void bindModel();
+
+    //hides the removed vertices in the vertice glyphs
+    void updateVertMask();
+
+    //vertice and edge radius from the shortest edge
+    void resetRadii();
+
+    //arcs are drawn to within half a pixel of the renderer ren
+    void updateArcTolerance(vtkRenderer *ren);
+
+    //DATA
+    bool isRendering;
+    //the vertices with a mask for the glyphs, shares the model vertices
+    vtkSmartPointer<vtkPolyData> vertGlyphData;
+    vtkTimeStamp maskTime;   //last update of the vertice mask
+    vtkTimeStamp boundsTime; //last fit to HexBlocker::resetBounds
+    vtkSmartPointer<HexCollection> boundBlocks;
+    vtkSmartPointer<HexEdgeCollection> boundEdges;
+    vtkSmartPointer<HexPatchCollection> boundPatches;
+};
+
+#endif // HEXVIEW_H
@@ -25,11 +25,17 @@ License
 
 #include "InteractorStyleActorPick.h"
 #include "HexBlocker.h"
+#include "HexView.h"
 #include "HexBlock.h"
 #include "HexPatch.h"
+#include "HexPatchCollection.h"
 #include "HexEdge.h"
+#include "HexEdgeCollection.h"
+#include "HexBlockRepresentation.h"
+#include "HexEdgeRepresentation.h"
+#include "HexPatchRepresentation.h"
 //#include "HexBC.h"
-#include <vtkCollection.h>
+#include "HexCollection.h"
 #include <vtkObjectFactory.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkRenderWindow.h>
@@ -37,10 +43,10 @@ License
 #include <iostream>
 
 #include <vtkIdList.h>
-#include <vtkCollection.h>
 #include <vtkProp3D.h>
-#include <vtkProperty.h>
+#include <vtkActor.h>
 #include <vtkCellPicker.h>
+#include <vtkCellLocator.h>
 
 
 vtkStandardNewMacro(InteractorStyleActorPick);
@@ -50,10 +56,11 @@ InteractorStyleActorPick::InteractorStyleActorPick() : QObject()
     selectionMode = multi;
     selectionType = block;
     hexBlocker=0;
+    hexView=0;
     selectedIds = vtkSmartPointer<vtkIdList>::New();
 
     InteractionPicker = vtkSmartPointer<vtkCellPicker>::New();
-    InteractionPicker->SetTolerance(0.001);
+    InteractionPicker->SetTolerance(HexView::pickTolerance);
 }
 
 InteractorStyleActorPick::~InteractorStyleActorPick()
@@ -75,10 +82,11 @@ void InteractorStyleActorPick::OnChar()
     }
 }
 
-void InteractorStyleActorPick::setHexBlocker(HexBlocker *hexb)
+void InteractorStyleActorPick::setHexBlocker(HexBlocker *hexb, HexView *view)
 {
     hexBlocker=hexb;
-    this->SetCurrentRenderer(hexBlocker->renderer);
+    hexView=view;
+    this->SetCurrentRenderer(hexView->renderer);
 }
 
 void InteractorStyleActorPick::setSelection(selectionTypes type, selectionModes mode)
@@ -99,45 +107,38 @@ vtkIdType InteractorStyleActorPick::findClickedActorId()
     int y = this->Interactor->GetEventPosition()[1];
 
     this->FindPokedRenderer(x, y);
+    this->setPickTarget();
     this->findPickedActor(x, y);
 
     switch(selectionType)
     {
     case block:
     {
-        for(vtkIdType i = 0; i< hexBlocker->hexBlocks->GetNumberOfItems();i++)
+        //all blocks share one actor, the picked cell tells which block
+        if(this->InteractionProp == hexView->blockRep->actor)
         {
-            HexBlock * hb = HexBlock::SafeDownCast(hexBlocker->hexBlocks->GetItemAsObject(i));
-            if(this->InteractionProp == hb->hexBlockActor)
-            {
-                clickedActorId = i;
-            }
+            clickedActorId = hexView->blockRep->getBlockId(
+                        this->InteractionPicker->GetCellId());
         }
         break;
     }
     case patch:
     {
-        for(vtkIdType i = 0; i< hexBlocker->patches->GetNumberOfItems();i++)
+        //all patches share one actor, the picked cell tells which patch
+        if(this->InteractionProp == hexView->patchRep->actor)
         {
-            HexPatch *p = HexPatch::SafeDownCast(
-                        hexBlocker->patches->GetItemAsObject(i));
-            if(this->InteractionProp == p->actor)
-            {
-                clickedActorId = i;
-            }
+            clickedActorId = hexView->patchRep->getPatchId(
+                        this->InteractionPicker->GetCellId());
         }
         break;
     }
     case edge:
     {
-        for(vtkIdType i = 0; i< hexBlocker->edges->GetNumberOfItems();i++)
+        //all edges share one actor, the picked cell tells which edge
+        if(this->InteractionProp == hexView->edgeRep->actor)
         {
-            HexEdge *e = HexEdge::SafeDownCast(
-                        hexBlocker->edges->GetItemAsObject(i));
-            if(this->InteractionProp == e->actor)
-            {
-                clickedActorId = i;
-            }
+            clickedActorId = hexView->edgeRep->getEdgeId(
+                        this->InteractionPicker->GetCellId());
         }
         break;
     }
@@ -187,8 +188,6 @@ void InteractorStyleActorPick::OnLeftButtonUp()
     if(clickedActor<0)
         return;
 
-    vtkActor * act = vtkActor::SafeDownCast(this->InteractionProp);
-
     //return from function depending on mode
     switch(selectionMode)
     {
@@ -207,7 +206,7 @@ void InteractorStyleActorPick::OnLeftButtonUp()
         }
         case 1:
         {//Set blue color and return
-            act->GetProperty()->SetColor(0.1,0.1,1);
+            setClickedColor(clickedActor,0.1,0.1,1);
             hexBlocker->render();
             selectedIds->InsertUniqueId(clickedActor);
             return;
@@ -225,7 +224,7 @@ void InteractorStyleActorPick::OnLeftButtonUp()
     }
     //set red color
     selectedIds->InsertUniqueId(clickedActor);
-    act->GetProperty()->SetColor(1,0.1,0.1);
+    setClickedColor(clickedActor,1,0.1,0.1);
     hexBlocker->render();
 
 }
@@ -311,6 +310,67 @@ void InteractorStyleActorPick::OnMiddleButtonUp()
 
 }
 
+void InteractorStyleActorPick::setClickedColor(vtkIdType clickedActor,
+                                               double r, double g, double b)
+{
+    switch(selectionType)
+    {
+    case block:
+    {
+        HexBlock * hb = HexBlock::SafeDownCast(
+                    hexBlocker->hexBlocks->GetItemAsObject(clickedActor));
+        hb->setColor(r,g,b);
+        break;
+    }
+    case patch:
+    {
+        HexPatch * p = HexPatch::SafeDownCast(
+                    hexBlocker->patches->GetItemAsObject(clickedActor));
+        p->setColor(r,g,b);
+        break;
+    }
+    case edge:
+    {
+        HexEdge * e = HexEdge::SafeDownCast(
+                    hexBlocker->edges->GetItemAsObject(clickedActor));
+        e->setColor(r,g,b);
+        break;
+    }
+    }
+}
+
+void InteractorStyleActorPick::setPickTarget()
+{
+    vtkActor *actor = NULL;
+    vtkCellLocator *locator = NULL;
+    switch(selectionType)
+    {
+    case block:
+        actor = hexView->blockRep->actor;
+        locator = hexView->blockRep->getLocator();
+        break;
+    case patch:
+        actor = hexView->patchRep->actor;
+        locator = hexView->patchRep->getLocator();
+        break;
+    case edge:
+        actor = hexView->edgeRep->actor;
+        locator = hexView->edgeRep->getLocator();
+        break;
+    }
+
+    //only the actor of the selected type can be hit, so e.g. an edge
+    //in front of a patch doesn't hide it
+    this->InteractionPicker->InitializePickList();
+    this->InteractionPicker->RemoveAllLocators();
+    this->InteractionPicker->SetTolerance(HexView::pickTolerance);
+    if(actor == NULL)
+        return;
+    this->InteractionPicker->AddPickList(actor);
+    this->InteractionPicker->PickFromListOn();
+    this->InteractionPicker->AddLocator(locator);
+}
+
 void InteractorStyleActorPick::findPickedActor(int x, int y)
 {
   this->InteractionPicker->Pick(x, y, 0.0, this->CurrentRenderer);
@@ -40,10 +40,11 @@ Description
 #include <vtkInteractorStyleTrackballCamera.h>
 #include <QObject>
 
-class vtkCollection;
+class HexCollection;
 class vtkIdList;
 class HexBC;
 class HexBlocker;
+class HexView;
 class vtkCellPicker;
 
 class InteractorStyleActorPick : public QObject, public vtkInteractorStyleTrackballCamera
@@ -70,7 +71,8 @@ public:
     enum selectionModes{single=1,pair=2,multi=3};
 
     //FUNCTIONS
-    void setHexBlocker(HexBlocker *hexb);
+    //the model to select in and the view it is drawn in
+    void setHexBlocker(HexBlocker *hexb, HexView *view);
     virtual vtkIdType findClickedActorId();
     virtual void OnLeftButtonDown();
     virtual void OnLeftButtonUp();
@@ -96,11 +98,17 @@ private:
     //FUNCTIONS
     bool didMouseMove();
     void storePosition();
+    //restricts the picker to the actor of the selection type and
+    //gives it the cell locator of that actor's data
+    void setPickTarget();
     void findPickedActor(int x,int y);
+    //colors the object at clickedActor in the selected list type
+    void setClickedColor(vtkIdType clickedActor, double r, double g, double b);
 
     //DATA
     int lastXpos,lastYpos;
     HexBlocker * hexBlocker;
+    HexView * hexView;
 
     selectionTypes selectionType;
     selectionModes selectionMode;
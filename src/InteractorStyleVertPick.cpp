@@ -42,13 +42,12 @@ License
 #include <vtkInteractorStyleRubberBandPick.h>
 #include <vtkAreaPicker.h>
 #include <vtkExtractGeometry.h>
-#include <vtkDataSetMapper.h>
 #include <vtkUnstructuredGrid.h>
 //#include <vtkVertexGlyphFilter.h>
 //#include <vtkIdFilter.h>
 
 #include <vtkPoints.h>
-#include <vtkGlyph3D.h>
+#include <vtkGlyph3DMapper.h>
 #include <vtkSphereSource.h>
 #include <vtkLine.h>
 #include <vtkQuad.h>
@@ -58,11 +57,10 @@ vtkStandardNewMacro(InteractorStyleVertPick);
 
 InteractorStyleVertPick::InteractorStyleVertPick()
 {
-    this->SelectedGlyph = vtkSmartPointer<vtkGlyph3D>::New();
+    this->SelectedGlyph = vtkSmartPointer<vtkGlyph3DMapper>::New();
     this->SelectedSphere = vtkSmartPointer<vtkSphereSource>::New();
-    this->SelectedMapper = vtkSmartPointer<vtkDataSetMapper>::New();
     this->SelectedActor = vtkSmartPointer<vtkActor>::New();
-    this->SelectedActor->SetMapper(SelectedMapper);
+    this->SelectedActor->SetMapper(SelectedGlyph);
     this->SelectedList = vtkSmartPointer<vtkIdList>::New();
 }
 
@@ -150,17 +148,11 @@ void InteractorStyleVertPick::OnLeftButtonUp()
 
     }
 
+    //the selected vertices are drawn as instances of the vertice sphere
     SelectedGlyph->SetInputConnection(extractGeometry->GetOutputPort());
     SelectedGlyph->SetSourceConnection(SelectedSphere->GetOutputPort());
-    SelectedGlyph->SetScaleModeToDataScalingOff();
-    SelectedGlyph->Update();
-
-#if VTK_MAJOR_VERSION <= 5
-    this->SelectedMapper->SetInput(SelectedGlyph->GetOutput());
-#else
-    this->SelectedMapper->SetInputConnection(SelectedGlyph->GetOutputPort());
-#endif
-    this->SelectedMapper->ScalarVisibilityOff();
+    SelectedGlyph->ScalingOff();
+    SelectedGlyph->ScalarVisibilityOff();
     this->SelectedActor->GetProperty()->SetColor(1.0, 0.0, 0.0); //(R,G,B)
     this->SelectedActor->SetVisibility(1);
 
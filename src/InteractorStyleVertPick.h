@@ -37,9 +37,8 @@ Description
 #include <QObject>
 
 class vtkPolyData;
-class vtkGlyph3D;
+class vtkGlyph3DMapper;
 class vtkSphereSource;
-class vtkDataSetMapper;
 class vtkActor;
 class vtkIdList;
 class vtkExtractGeometry;
@@ -82,13 +81,12 @@ public:
     vtkSmartPointer<vtkActor> SelectedActor;
     vtkSmartPointer<vtkIdList> SelectedList;
     vtkSmartPointer<vtkPolyData> Points;
-    vtkSmartPointer<vtkGlyph3D> SelectedGlyph;
+    vtkSmartPointer<vtkGlyph3DMapper> SelectedGlyph;
 
 signals:
     void selectionDone();
 
 private:
-    vtkSmartPointer<vtkDataSetMapper> SelectedMapper;
 //    vtkSmartPointer<vtkExtractGeometry> extractGeometry;
 };
 
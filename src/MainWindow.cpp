@@ -27,7 +27,11 @@ License
 #include "ui_MainWindow.h"
 #include "MainWindow.h"
 #include "HexBlocker.h"
+#include "HexView.h"
+#include "HexRenderScheduler.h"
 #include "HexBlock.h"
+#include "HexGeometry.h"
+#include "HexCollection.h"
 #include "InteractorStyleVertPick.h"
 #include "InteractorStyleActorPick.h"
 #include "ToolBoxWidget.h"
@@ -69,20 +73,21 @@ MainWindow::MainWindow()
     this->ui->setupUi(this);
 
     hexBlocker = new HexBlocker();
-    hexBlocker->renderer->SetBackground(.2, .3, .4);
+    hexView = new HexView(hexBlocker);
+    hexView->renderer->SetBackground(.2, .3, .4);
 
     // VTK/Qt wedded
     renwin = this->ui->qvtkWidget->GetRenderWindow();
-    renwin->AddRenderer(hexBlocker->renderer);
-    hexBlocker->initOrientationAxes(renwin);
+    renwin->AddRenderer(hexView->renderer);
+    hexView->initOrientationAxes(renwin);
 
     //Area Picker and InteractorStyles
     areaPicker = vtkSmartPointer<vtkAreaPicker>::New();
     styleVertPick = vtkSmartPointer<InteractorStyleVertPick>::New();
     styleVertPick->SetPoints(hexBlocker->vertData);
-    styleVertPick->SelectedSphere=hexBlocker->vertSphere;
+    styleVertPick->SelectedSphere=hexView->vertSphere;
     styleActorPick = vtkSmartPointer<InteractorStyleActorPick>::New();
-    styleActorPick->setHexBlocker(hexBlocker);
+    styleActorPick->setHexBlocker(hexBlocker,hexView);
 
     defStyle = vtkSmartPointer<vtkInteractorStyleTrackballCamera>::New();
 
@@ -94,12 +99,14 @@ MainWindow::MainWindow()
     verticeEditor = new VerticeEditorWidget();
     this->addDockWidget(Qt::RightDockWidgetArea,verticeEditor);
     verticeEditor->setHexBlocker(hexBlocker);
+    snapToFeatures = false;
     hexBlocker->render();
 
     // Set up action signals and slots
     connect(this->ui->actionView_tool_bar,SIGNAL(triggered()),this,SLOT(slotViewToolBar()));
     connect(this->ui->actionView_tool_box,SIGNAL(triggered()),this,SLOT(slotViewToolBox()));
     connect(this->ui->actionScaleMesh,SIGNAL(triggered()),this,SLOT(slotSetMeshScale()));
+    connect(this->ui->actionMergeTolerance,SIGNAL(triggered()),this,SLOT(slotSetMergeTolerance()));
     connect(this->ui->actionScaleGeometry,SIGNAL(triggered()),this,SLOT(slotSetGeometryScale()));
     connect(this->ui->actionZoomOut, SIGNAL(triggered()), this, SLOT(slotZoomOut()));
     connect(this->ui->actionExit, SIGNAL(triggered()), this, SLOT(slotExit()));
@@ -118,6 +125,9 @@ MainWindow::MainWindow()
     connect(toolbox->rotateVerticesW,SIGNAL(rotateDone()),this,SLOT(slotResetInteractor()));
     connect(toolbox->rotateVerticesW,SIGNAL(rotateVertices()),this,SLOT(slotRotateVertices()));
     connect(this->ui->actionSnapVertices,SIGNAL(triggered()),this,SLOT(slotSnapVertices()));
+    connect(this->ui->actionSnapVerticesToFeatures,SIGNAL(triggered()),this,SLOT(slotSnapVerticesToFeatures()));
+    connect(this->ui->actionSnapArcsToFeatures,SIGNAL(triggered()),this,SLOT(slotStartSnapArcsToFeatures()));
+    connect(this->ui->actionSetFeatureAngle,SIGNAL(triggered()),this,SLOT(slotSetFeatureAngle()));
     connect(this->ui->actionSetBCs,SIGNAL(triggered()),this,SLOT(slotOpenSetBCsDialog()));
     connect(toolbox->setBCsW,SIGNAL(startSelectPatches(vtkIdList *)),this,SLOT(slotStartSelectPatches(vtkIdList *)));
     connect(toolbox->setBCsW,SIGNAL(resetInteractor()), this, SLOT(slotResetInteractor()));
@@ -131,7 +141,10 @@ MainWindow::MainWindow()
     connect(this->ui->actionOpenBlockMeshDict,SIGNAL(triggered()),this, SLOT(slotOpenBlockMeshDict()));
     connect(this->ui->actionReOpenBlockMeshDict,SIGNAL(triggered()),this, SLOT(slotReOpenBlockMeshDict()));
     connect(this->ui->actionOpenGeometry,SIGNAL(triggered()),this, SLOT(slotOpenGeometry()));
+    connect(this->ui->actionRemoveGeometry,SIGNAL(triggered()),this, SLOT(slotRemoveGeometry()));
     connect(this->ui->actionSave,SIGNAL(triggered()),this,SLOT(slotSaveBlockMeshDict()));
+    connect(this->ui->actionUndo,SIGNAL(triggered()),this,SLOT(slotUndo()));
+    connect(this->ui->actionRedo,SIGNAL(triggered()),this,SLOT(slotRedo()));
     connect(this->ui->actionSaveAs,SIGNAL(triggered()),this, SLOT(slotSaveAsBlockMeshDict()));
     connect(this->ui->actionMergePatch,SIGNAL(triggered()),this,SLOT(slotStartMergePatch()));
     connect(this->ui->actionDeleteBlocks,SIGNAL(triggered()),this,SLOT(slotStartDeleteHexBlock()));
@@ -145,6 +158,12 @@ MainWindow::MainWindow()
             this,SLOT(slotHexObjVisibility()));
     connect(this->ui->actionVertIDVisibility,SIGNAL(triggered()),
             this,SLOT(slotHexObjVisibility()));
+    connect(this->ui->actionBlockIDVisibility,SIGNAL(triggered()),
+            this,SLOT(slotHexObjVisibility()));
+    connect(this->ui->actionPatchIDVisibility,SIGNAL(triggered()),
+            this,SLOT(slotHexObjVisibility()));
+    connect(this->ui->actionEdgeIDVisibility,SIGNAL(triggered()),
+            this,SLOT(slotHexObjVisibility()));
     connect(this->ui->actionGeometryVisibility,SIGNAL(triggered()),
             this,SLOT(slotHexObjVisibility()));
     connect(this->ui->actionViewVerticeEditor,SIGNAL(toggled(bool)),
@@ -156,6 +175,7 @@ MainWindow::MainWindow()
             this,SLOT(slotAboutDialog()));
     connect(this->ui->actionArbitraryTest,SIGNAL(triggered()),this,SLOT(slotArbitraryTest()));
 
+    qApp->installEventFilter(this);
 }
 
 MainWindow::~MainWindow()
@@ -164,6 +184,27 @@ MainWindow::~MainWindow()
 
 }
 
+bool MainWindow::eventFilter(QObject *obj, QEvent *event)
+{
+    //the press is seen first by the widget under the mouse
+    switch(event->type())
+    {
+    case QEvent::MouseButtonPress:
+    case QEvent::KeyPress:
+        hexView->renderScheduler->beginOperation(obj->objectName().isEmpty() ?
+                                                     obj->metaObject()->className() :
+                                                     obj->objectName().toAscii().data());
+        break;
+    case QEvent::MouseButtonRelease:
+    case QEvent::KeyRelease:
+        hexView->renderScheduler->endOperation();
+        break;
+    default:
+        break;
+    }
+    return QMainWindow::eventFilter(obj,event);
+}
+
 // Action to be taken upon file open 
 void MainWindow::slotZoomOut()
 {
@@ -198,7 +239,7 @@ void MainWindow::slotStartDeleteHexBlock()
         );
     renwin->GetInteractor()->SetInteractorStyle(styleActorPick);
 
-    hexBlocker->hidePatches();
+    hexView->hidePatches();
     hexBlocker->render();
     connect(styleActorPick,SIGNAL(selectionDone()),this,SLOT(slotDeleteHexBlock()));
 
@@ -211,7 +252,7 @@ void MainWindow::slotDeleteHexBlock()
     renwin->GetInteractor()->SetInteractorStyle(defStyle);
     vtkIdList * selIds = styleActorPick->selectedIds;
     hexBlocker->removeHexBlocks(selIds);
-    hexBlocker->showPatches();
+    hexView->showPatches();
     verticeEditor->updateVertices();
     hexBlocker->render();
 }
@@ -346,21 +387,114 @@ void MainWindow::slotRotateVertices()
 
 void MainWindow::slotSnapVertices()
 {
+    snapToFeatures = false;
     connect(styleVertPick,SIGNAL(selectionDone()),
                this,SLOT(toSnapVertices()));
     slotStartSelectVertices();
 }
 
+void MainWindow::slotSnapVerticesToFeatures()
+{
+    snapToFeatures = true;
+    connect(styleVertPick,SIGNAL(selectionDone()),
+               this,SLOT(toSnapVertices()));
+    slotStartSelectVertices();
+}
+
+//progress of snapVertices, false if the user cancels
+static bool snapProgress(double fraction, void *clientData)
+{
+    QProgressDialog *dialog = static_cast<QProgressDialog *>(clientData);
+    dialog->setValue(int(100*fraction));
+    qApp->processEvents();
+    return !dialog->wasCanceled();
+}
+
+bool MainWindow::selectGeometry(const QString &title, vtkIdType &geoId)
+{
+    //with several geometries ask which one to snap to
+    geoId = -1;
+    vtkIdType numGeos = hexBlocker->geometries->GetNumberOfItems();
+    if(numGeos == 0)
+    {
+        ui->statusbar->showMessage(tr("No geometry to snap to."),5000);
+        return false;
+    }
+    if(numGeos == 1)
+        return true;
+
+    QStringList items;
+    items << tr("all geometries");
+    for(vtkIdType i=0;i<numGeos;i++)
+        items << QString("%1: %2").arg(i).arg(HexGeometry::SafeDownCast(
+                     hexBlocker->geometries->GetItemAsObject(i))->name.c_str());
+    bool ok;
+    QString item = QInputDialog::getItem(this,title,tr("Snap to:"),items,0,false,&ok);
+    geoId = items.indexOf(item)-1;
+    return ok;
+}
+
 void MainWindow::toSnapVertices()
 {
     disconnect(styleVertPick,SIGNAL(selectionDone()),
                this,SLOT(toSnapVertices()));
-    hexBlocker->snapVertices(styleVertPick->SelectedList);
+    vtkIdType geoId;
+    if(selectGeometry(tr("Snap vertices"),geoId))
+    {
+        //shown at once: snapProgress processes events while the
+        //locators are searched, so the window must not take input
+        //that could e.g. remove the geometry being searched
+        QProgressDialog dialog(tr("Snapping vertices..."),tr("Cancel"),0,100,this);
+        dialog.setWindowModality(Qt::WindowModal);
+        dialog.setMinimumDuration(0);
+        dialog.show();
+        bool done = snapToFeatures ?
+                    hexBlocker->snapVerticesToFeatures(styleVertPick->SelectedList,geoId,
+                                                       snapProgress,&dialog) :
+                    hexBlocker->snapVertices(styleVertPick->SelectedList,geoId,
+                                             snapProgress,&dialog);
+        if(!done)
+            ui->statusbar->showMessage(tr("Snapping cancelled, no vertice was moved."),5000);
+    }
     slotResetInteractor();
     verticeEditor->updateVertices();
     hexBlocker->render();
 }
 
+void MainWindow::slotStartSnapArcsToFeatures()
+{
+    ui->statusbar->showMessage(tr("Select arcs, middle button when finished"),5000);
+    hexBlocker->resetColors();
+    styleActorPick->setSelection(InteractorStyleActorPick::edge,
+                                 InteractorStyleActorPick::multi);
+    renwin->GetInteractor()->SetInteractorStyle(styleActorPick);
+    connect(styleActorPick,SIGNAL(selectionDone()),
+            this,SLOT(slotSnapArcsToFeatures()));
+    hexBlocker->render();
+}
+
+void MainWindow::slotSnapArcsToFeatures()
+{
+    disconnect(styleActorPick,SIGNAL(selectionDone()),
+               this,SLOT(slotSnapArcsToFeatures()));
+    vtkIdType geoId;
+    if(selectGeometry(tr("Snap arcs"),geoId))
+        hexBlocker->snapArcsToFeatures(styleActorPick->selectedIds,geoId);
+    slotResetInteractor();
+}
+
+void MainWindow::slotSetFeatureAngle()
+{
+    bool ok;
+    double angle = QInputDialog::getDouble(this,tr("Feature angle"),
+                                           tr("Angle between surface normals at a feature edge (degrees):"),
+                                           hexBlocker->featureAngle,0,180,1,&ok);
+    if(!ok)
+        return;
+    hexBlocker->setFeatureAngle(angle);
+    hexBlocker->render();
+}
+
 void MainWindow::slotRender()
 {
     hexBlocker->render();
@@ -403,22 +537,24 @@ void MainWindow::slotPatchSelectionDone()
 void MainWindow::slotNewCase()
 {
 
-    hexBlocker->removeOrientationAxes();
-    renwin->RemoveRenderer(hexBlocker->renderer);
+    hexView->removeOrientationAxes();
+    renwin->RemoveRenderer(hexView->renderer);
 
+    delete hexView;
     delete hexBlocker;
     hexBlocker = new HexBlocker();
-    hexBlocker->renderer->SetBackground(.2, .3, .4);
+    hexView = new HexView(hexBlocker);
+    hexView->renderer->SetBackground(.2, .3, .4);
 
-    renwin->AddRenderer(hexBlocker->renderer);
-    hexBlocker->initOrientationAxes(renwin);
+    renwin->AddRenderer(hexView->renderer);
+    hexView->initOrientationAxes(renwin);
     // repoint Axes interactor and widget
 //    widget->SetInteractor( renwin->GetInteractor() );
 
     //Repoint interactors.
     styleVertPick->SetPoints(hexBlocker->vertData);
-    styleVertPick->SelectedSphere=hexBlocker->vertSphere;
-    styleActorPick->setHexBlocker(hexBlocker);
+    styleVertPick->SelectedSphere=hexView->vertSphere;
+    styleActorPick->setHexBlocker(hexBlocker,hexView);
 
     //Repoint widgets
     // rensa bc's
@@ -427,6 +563,7 @@ void MainWindow::slotNewCase()
     toolbox->setHexBlockerPointer(hexBlocker);
     toolbox->setBCsW->clearBCs();
     verticeEditor->setHexBlocker(hexBlocker);
+    snapToFeatures = false;
     slotRender();
 }
 
@@ -496,6 +633,41 @@ void MainWindow::slotSetMeshScale()
     verticeEditor->displayScale(conv2meters);
 }
 
+void MainWindow::slotSetMergeTolerance()
+{
+    ui->statusbar->clearMessage();
+    QString title = tr("Merge tolerance");
+    QString label = tr("New vertices closer than this to an existing vertice use it instead.");
+
+    bool ok1;
+    double tol = QInputDialog::getDouble(this,title,label,hexBlocker->getMergeTolerance(),0,1e255,6,&ok1);
+
+    if(!ok1)
+    {
+        this->ui->statusbar->showMessage("Cancelled",3000);
+        return;
+    }
+    hexBlocker->setMergeTolerance(tol);
+}
+
+void MainWindow::slotUndo()
+{
+    if(!hexBlocker->undo())
+        ui->statusbar->showMessage("Nothing to undo",3000);
+    toolbox->setBCsW->updateBCs();
+    verticeEditor->updateVertices();
+    slotResetInteractor();
+}
+
+void MainWindow::slotRedo()
+{
+    if(!hexBlocker->redo())
+        ui->statusbar->showMessage("Nothing to redo",3000);
+    toolbox->setBCsW->updateBCs();
+    verticeEditor->updateVertices();
+    slotResetInteractor();
+}
+
 void MainWindow::slotSetGeometryScale()
 {
     ui->statusbar->clearMessage();
@@ -559,32 +731,35 @@ void MainWindow::slotReOpenBlockMeshDict()
 
     file.close();
 
-    hexBlocker->removeOrientationAxes();
-    renwin->RemoveRenderer(hexBlocker->renderer);
+    hexView->removeOrientationAxes();
+    renwin->RemoveRenderer(hexView->renderer);
 
+    delete hexView;
     delete hexBlocker;
     hexBlocker = new HexBlocker();
-    hexBlocker->renderer->SetBackground(.2, .3, .4);
+    hexView = new HexView(hexBlocker);
+    hexView->renderer->SetBackground(.2, .3, .4);
     hexBlocker->setModelScale(reader->convertToMeters);
 
     //reset pointers to hexBlocker in gui-classes
     toolbox->setHexBlockerPointer(hexBlocker);
 
-    renwin->AddRenderer(hexBlocker->renderer);
+    renwin->AddRenderer(hexView->renderer);
 
     hexBlocker->readBlockMeshDict(reader);
-    hexBlocker->initOrientationAxes(renwin);
+    hexView->initOrientationAxes(renwin);
     hexBlocker->edgesDict = reader->edgesDict;
 
     //Repoint interactors.
     styleVertPick->SetPoints(hexBlocker->vertData);
-    styleVertPick->SelectedSphere=hexBlocker->vertSphere;
-    styleActorPick->setHexBlocker(hexBlocker);
+    styleVertPick->SelectedSphere=hexView->vertSphere;
+    styleActorPick->setHexBlocker(hexBlocker,hexView);
 
     slotRender();
     //Repoint widgets
     toolbox->setBCsW->changeBCs(reader);
     verticeEditor->setHexBlocker(hexBlocker);
+    snapToFeatures = false;
 //    verticeEditor->updateVertices();
     verticeEditor->displayScale(hexBlocker->convertToMeters);
 
@@ -609,10 +784,34 @@ void MainWindow::slotOpenGeometry()
     }
     QByteArray ba = filename.toLatin1();
     char *openFileName = ba.data();
-    hexBlocker->readGeometry(openFileName);
+    if(!hexBlocker->readGeometry(openFileName))
+    {
+        ui->statusbar->showMessage("Could not read the geometry",10000);
+        return;
+    }
     ui->statusbar->showMessage("Adjust the geometry size in \"Tools/Set geometry scale\"",10000);
 }
 
+void MainWindow::slotRemoveGeometry()
+{
+    vtkIdType numGeos = hexBlocker->geometries->GetNumberOfItems();
+    if(numGeos == 0)
+    {
+        ui->statusbar->showMessage(tr("No geometry to remove."),5000);
+        return;
+    }
+
+    QStringList items;
+    for(vtkIdType i=0;i<numGeos;i++)
+        items << QString("%1: %2").arg(i).arg(HexGeometry::SafeDownCast(
+                     hexBlocker->geometries->GetItemAsObject(i))->name.c_str());
+    bool ok;
+    QString item = QInputDialog::getItem(this,tr("Remove geometry"),tr("Remove:"),
+                                         items,0,false,&ok);
+    if(ok)
+        hexBlocker->removeGeometry(items.indexOf(item));
+}
+
 void MainWindow::slotShowStatusText(QString text)
 {
     //Show for 10 secs
@@ -755,10 +954,13 @@ void MainWindow::slotMergePatch()
 void MainWindow::slotHexObjVisibility()
 {
     //maybe set all here
-    hexBlocker->visibilityBlocks(this->ui->actionBlockVisibility->isChecked());
-    hexBlocker->visibilityPatches(this->ui->actionPatchVisibility->isChecked());
-    hexBlocker->visibilityEdges(this->ui->actionEdgeVisibility->isChecked());
-    hexBlocker->visibilityVertIDs(this->ui->actionVertIDVisibility->isChecked());
+    hexView->visibilityBlocks(this->ui->actionBlockVisibility->isChecked());
+    hexView->visibilityPatches(this->ui->actionPatchVisibility->isChecked());
+    hexView->visibilityEdges(this->ui->actionEdgeVisibility->isChecked());
+    hexView->visibilityVertIDs(this->ui->actionVertIDVisibility->isChecked());
+    hexView->visibilityBlockIDs(this->ui->actionBlockIDVisibility->isChecked());
+    hexView->visibilityPatchIDs(this->ui->actionPatchIDVisibility->isChecked());
+    hexView->visibilityEdgeIDs(this->ui->actionEdgeIDVisibility->isChecked());
     hexBlocker->visibilityGeometry(this->ui->actionGeometryVisibility->isChecked());
     hexBlocker->render();
 }
@@ -766,7 +968,7 @@ void MainWindow::slotHexObjVisibility()
 void MainWindow::slotStartSelectPatchForEdgeSetType()
 {
     this->ui->actionPatchVisibility->setChecked(true);
-    hexBlocker->visibilityPatches(true);
+    hexView->visibilityPatches(true);
     styleActorPick->setSelection(InteractorStyleActorPick::patch,InteractorStyleActorPick::single);
     renwin->GetInteractor()->SetInteractorStyle(styleActorPick);
     ui->statusbar->showMessage("Select a patch with left button, deselect with right, middle when done.",10000);
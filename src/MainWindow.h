@@ -49,6 +49,7 @@ class vtkRenderWindow;
 class vtkPolyData;
 class vtkPoints;
 class HexBlocker;
+class HexView;
 class vtkRenderWindowInteractor;
 class vtkAxesActor;
 class vtkOrientationMarkerWidget;
@@ -108,6 +109,7 @@ public slots:
   void slotOpenBlockMeshDict();
   void slotReOpenBlockMeshDict();
   void slotOpenGeometry();
+  void slotRemoveGeometry();
   void slotSaveAsBlockMeshDict();
   void slotSaveBlockMeshDict();
   void slotRender();
@@ -124,18 +126,29 @@ public slots:
   void slotStartSelectPatchForEdgeSetType();
   void slotStartSelectPatchForEdgeSetTypeDone();
   void slotSetMeshScale();
+  void slotSetMergeTolerance();
   void slotSetGeometryScale();
   void slotSnapVertices();
+  void slotSnapVerticesToFeatures();
   void toSnapVertices();
+  void slotStartSnapArcsToFeatures();
+  void slotSnapArcsToFeatures();
+  void slotSetFeatureAngle();
+  void slotUndo();
+  void slotRedo();
 
 
 protected:
-   
+  //every click, drag or key press is an operation for the render
+  //counters, see HexRenderScheduler
+  bool eventFilter(QObject *obj, QEvent *event);
+
 protected slots:
 
 private:
   vtkRenderWindow                         *renwin;
   HexBlocker                              *hexBlocker;
+  HexView                                 *hexView;
   vtkSmartPointer<vtkInteractorStyleTrackballCamera> defStyle;
   vtkSmartPointer<vtkAreaPicker> areaPicker;
 
@@ -144,6 +157,11 @@ private:
   // Designer form
   Ui_MainWindow *ui;
   QString saveFileName;
+  bool snapToFeatures; //toSnapVertices snaps to feature curves
+
+  //asks which geometry to snap to if there are several, geoId is -1 for
+  //all. False if there is none or the user cancels.
+  bool selectGeometry(const QString &title, vtkIdType &geoId);
 
 };
 
@@ -143,25 +143,23 @@ bool PointsTableModel::setData(const QModelIndex &index, const QVariant &value,
     if (isDouble && index.isValid() && role == Qt::EditRole && hasPointsBeenSet && col < 4)
     {
         double pos[3];
+        vtkIdType id;
         if( showOnlyIds != 0 && row < showOnlyIds->GetNumberOfIds())
         {
-            points->GetPoint(showOnlyIds->GetId(row),pos);
-            pos[col-1]=val;
-            points->SetPoint(showOnlyIds->GetId(row),pos);
+            id=showOnlyIds->GetId(row);
         }
         else if(row < points->GetNumberOfPoints())
         {
-            points->GetPoint(row,pos);
-            pos[col-1]=val;
-            points->SetPoint(row,pos);
+            id=row;
         }
         else
         {
             return false;
         }
+        points->GetPoint(id,pos);
+        pos[col-1]=val;
 
-        points->Modified();
-        emit pointEdited();
+        emit pointEdited(id,pos[0],pos[1],pos[2]);
 //        emit dataChanged(index, index);
 
         return true;
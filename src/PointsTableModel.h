@@ -31,6 +31,7 @@ Description
 #define POINTSTABLEMODEL_H
 
 #include <QAbstractTableModel>
+#include <vtkType.h>
 
 class vtkPoints;
 class vtkIdList;
@@ -62,7 +63,9 @@ private:
     bool hasPointsBeenSet;
 
 signals:
-    void pointEdited();
+    //the table doesn't change the points, the receiver sets
+    //point id to the edited position
+    void pointEdited(vtkIdType id, double x, double y, double z);
 };
 
 
@@ -29,8 +29,9 @@ License
 #include <QTreeWidget>
 #include "SetBCsItem.h"
 #include "HexBC.h"
+#include "HexPatchCollection.h"
 #include "HexReader.h"
-#include <vtkCollection.h>
+#include "HexCollection.h"
 #include <vtkSmartPointer.h>
 #include <vtkIdList.h>
 #include "HexBlocker.h"
@@ -64,20 +65,19 @@ SetBCsWidget::~SetBCsWidget()
 void SetBCsWidget::slotCreateBC()
 {
     SetBCsItem *bc = new SetBCsItem(ui->treeWidget);
-    bc->hexBC = vtkSmartPointer<HexBC>::New();
+    bc->hexBC = hexBlocker->createBC(tr("name").toStdString(),tr("patch").toStdString());
 
     bc->setFlags(bc->flags() | Qt::ItemIsEditable);
     bc->setText(0,tr("name"));
     bc->setText(1,tr("patch"));
-    bc->hexBC->globalPatches=hexBlocker->patches;
-    hexBlocker->hexBCs->AddItem(bc->hexBC);
 }
 
 void SetBCsWidget::slotBCchanged(QTreeWidgetItem *item, int col)
 {
     SetBCsItem *bc = static_cast<SetBCsItem*>(item);
-    bc->hexBC->name=bc->text(0).toStdString();
-    bc->hexBC->type=bc->text(1).toStdString();
+    if(bc->hexBC == NULL)
+        return;
+    hexBlocker->setBCName(bc->hexBC,bc->text(0).toStdString(),bc->text(1).toStdString());
 }
 
 void SetBCsWidget::slotSelectPatches()
@@ -106,7 +106,7 @@ void SetBCsWidget::slotSelectionDone(vtkIdList *selectedPatches)
     SetBCsItem *bcItem = static_cast<SetBCsItem*>(selectedTreeItem[0]);
     vtkIdType hexBCId = hexBlocker->hexBCs->IsItemPresent(bcItem->hexBC)-1;
     HexBC *hexBC = HexBC::SafeDownCast(hexBlocker->hexBCs->GetItemAsObject(hexBCId));
-    hexBC->insertPatches(selectedPatches);
+    hexBlocker->setBCPatches(hexBC,selectedPatches);
     emit resetInteractor();
 }
 
@@ -115,7 +115,7 @@ void SetBCsWidget::slotShowPatchesOnSelection(QTreeWidgetItem *item, int col)
     //Reset all colors first!
     emit resetInteractor();
     SetBCsItem *bcitem = static_cast<SetBCsItem*>(item);
-    bcitem->hexBC->setPatchColors(0.0,1.0,0.0);
+    bcitem->hexBC->setPatchColors(0.0,0.0,1.0);
     emit render();
 
 }
@@ -124,9 +124,16 @@ void SetBCsWidget::changeBCs(HexReader * reader)
 {
 
 
-    ui->treeWidget->clear();
     hexBlocker->hexBCs = reader->readBCs;
     hexBlocker->patches= reader->readPatches;
+    updateBCs();
+}
+
+void SetBCsWidget::updateBCs()
+{
+    //filling the list is not a rename
+    ui->treeWidget->blockSignals(true);
+    ui->treeWidget->clear();
     for(vtkIdType i=0;i<hexBlocker->hexBCs->GetNumberOfItems();i++)
     {
         vtkSmartPointer<HexBC> bc = HexBC::SafeDownCast(hexBlocker->hexBCs->GetItemAsObject(i));
@@ -143,6 +150,7 @@ void SetBCsWidget::changeBCs(HexReader * reader)
         ui->treeWidget->addTopLevelItem(bcitem);
 
     }
+    ui->treeWidget->blockSignals(false);
 }
 
 void SetBCsWidget::clearBCs()
@@ -170,6 +178,6 @@ void SetBCsWidget::slotDeleteBC()
         return;
     }
     HexBC *hexBC = HexBC::SafeDownCast(hexBlocker->hexBCs->GetItemAsObject(hexBCId));
-    hexBlocker->hexBCs->RemoveItem(hexBC);
+    hexBlocker->removeBC(hexBC);
 
 }
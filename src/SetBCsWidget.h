@@ -33,7 +33,7 @@ Description
 #include <QWidget>
 #include <vtkSmartPointer.h>
 
-class vtkCollection;
+class HexCollection;
 class QTreeWidgetItem;
 class vtkIdList;
 class HexReader;
@@ -53,6 +53,8 @@ public:
 
     void changeBCs(HexReader * reader);
     void clearBCs();
+    //fills the list from hexBlocker->hexBCs, e.g. after undo
+    void updateBCs();
 
     HexBlocker *hexBlocker;
 
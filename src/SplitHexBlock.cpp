@@ -25,75 +25,67 @@ License
 #include "HexBlocker.h"
 #include "HexBlock.h"
 #include "HexEdge.h"
+#include "HexEdgeCollection.h"
+#include "HexVertexLocator.h"
 #include "HexPatch.h"
+#include "HexIncidence.h"
+#include "HexEdgeClasses.h"
+#include "HexUndoStack.h"
 //#include "HexReader.h"
 
 //#include <vtkObjectFactory.h>
-#include <vtkCollection.h>
+#include "HexCollection.h"
 #include <vtkIdList.h>
-#include <vtkRenderer.h>
+#include <vector>
+#include <map>
+#include <algorithm>
 
 void HexBlocker::splitHexBlock(vtkIdType edgeId)
 {
-    HexEdge *edge;
-    vtkSmartPointer<vtkIdList> parallelEdges = vtkSmartPointer<vtkIdList>::New();
-    addParallelEdges(parallelEdges, edgeId);
-
-    vtkSmartPointer<vtkIdList> parallelBlocks = vtkSmartPointer<vtkIdList>::New();
-    for(vtkIdType i=0; i<hexBlocks->GetNumberOfItems(); i++)  // get parallel blocks
+    HexUndoStep step(undoStack,"split blocks");
+    HexEdge *edge = HexEdge::SafeDownCast(edges->GetItemAsObject(edgeId));
+    //a copy, the classes change as the new blocks are added
+    std::vector<HexEdge *> parallelEdges = edgeClasses->parallelEdges(edge);
+
+    // get parallel blocks and the parallel edges each one of them has
+    std::map<HexBlock *, std::vector<HexEdge *> > blockEdges;
+    for(size_t j=0; j<parallelEdges.size(); j++)
     {
-        HexBlock * b = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(i));
-        for(vtkIdType j=0; j<parallelEdges->GetNumberOfIds(); j++)
-        {
-            if (b->getParallelEdges(parallelEdges->GetId(j))->GetNumberOfIds() > 0)
-            {
-                parallelBlocks->InsertUniqueId(i);
-                break;
-            }
-        }
+        const HexIncidence::BlockList &eBlocks = incidence->edgeBlocks(parallelEdges[j]);
+        for(size_t k=0; k<eBlocks.size(); k++)
+            blockEdges[eBlocks[k]].push_back(parallelEdges[j]);
     }
-
-    vtkIdType nv, parBlockId, parEdgeId;
-    for(vtkIdType i=0; i<parallelBlocks->GetNumberOfIds(); i++)          // insert new blocks
+    //in the order of the global list
+    std::vector<vtkIdType> parallelBlocks;
+    std::map<HexBlock *, std::vector<HexEdge *> >::iterator it;
+    for(it=blockEdges.begin(); it!=blockEdges.end(); ++it)
+        parallelBlocks.push_back(hexBlocks->IsItemPresent(it->first)-1);
+    std::sort(parallelBlocks.begin(), parallelBlocks.end());
+
+    vtkIdType nv, parBlockId;
+    for(size_t i=0; i<parallelBlocks.size(); i++)          // insert new blocks
     {
-        parBlockId = parallelBlocks->GetId(i);
+        parBlockId = parallelBlocks[i];
         vtkSmartPointer<vtkIdList> baseVertices   = vtkSmartPointer<vtkIdList>::New();
         vtkSmartPointer<vtkIdList> middleVertices = vtkSmartPointer<vtkIdList>::New();
         vtkSmartPointer<vtkIdList> topVertices    = vtkSmartPointer<vtkIdList>::New();
         vtkSmartPointer<vtkIdList> blockVertices0 = vtkSmartPointer<vtkIdList>::New();
         vtkSmartPointer<vtkIdList> blockVertices1 = vtkSmartPointer<vtkIdList>::New();
         HexBlock * b = HexBlock::SafeDownCast(hexBlocks->GetItemAsObject(parBlockId));
-        for(vtkIdType j=0;j<parallelEdges->GetNumberOfIds();j++)
+        const std::vector<HexEdge *> &bEdges = blockEdges[b];
+        for(size_t j=0;j<bEdges.size();j++)
         {
-            parEdgeId = parallelEdges->GetId(j);
-            if (b->getParallelEdges(parEdgeId)->GetNumberOfIds() > 0)
-            {
-                double posm[3], tmpCoords[3];
-                edge = HexEdge::SafeDownCast(edges->GetItemAsObject(parEdgeId));
-                edge->calcParametricPointOnLine(0.5, posm);
-
-                nv = vertices->GetNumberOfPoints(); // create a new vertice if needed
-                vtkIdType ptId;                     // this code is copied from HexBlock::init()
-                for(ptId=0; ptId<nv; ptId++)
-                {
-                    vertices->GetPoint(ptId, tmpCoords);
-                    if(    tmpCoords[0] == posm[0]
-                        && tmpCoords[1] == posm[1]
-                        && tmpCoords[2] == posm[2] )
-                    {
-                        break;
-                    }
-                }
-                if(ptId==nv)
-                {
-                    vertices->InsertNextPoint(posm);
-                }
+            double posm[3];
+            edge = bEdges[j];
+            edge->calcParametricPointOnLine(0.5, posm);
+
+            // create a new vertice if needed
+            vtkIdType ptId = vertLocator->insertUniqueVertice(posm);
 // how to guarantee the correct order of the vertices ??
 // -> it still doesn't correct the middle point calculated using edges with inverted ends
-                middleVertices->InsertUniqueId(ptId);
-                baseVertices->InsertUniqueId(edge->getVertIds(0));
-                topVertices->InsertUniqueId(edge->getVertIds(1));
-            }
+            middleVertices->InsertUniqueId(ptId);
+            baseVertices->InsertUniqueId(edge->getVertIds(0));
+            topVertices->InsertUniqueId(edge->getVertIds(1));
         }
         vertices->Modified();
 
@@ -133,10 +125,11 @@ void HexBlocker::splitHexBlock(vtkIdType edgeId)
         createHexBlock(blockVertices1);
     }
 
-    for(vtkIdType i=parallelBlocks->GetNumberOfIds()-1; i>=0; i--)      // remove old blocks
-    {
-        removeHexBlock(parallelBlocks->GetId(i));
-    }
+    // remove old blocks, all at once
+    vtkSmartPointer<vtkIdList> oldBlocks = vtkSmartPointer<vtkIdList>::New();
+    for(size_t i=0; i<parallelBlocks.size(); i++)
+        oldBlocks->InsertNextId(parallelBlocks[i]);
+    removeHexBlocks(oldBlocks);
 }
 
 void HexBlocker::orderVertices(vtkIdList *selectedVertices)
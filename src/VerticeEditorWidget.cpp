@@ -29,6 +29,8 @@ License
 #include "PointsTableModel.h"
 #include <iostream>
 #include <vtkPoints.h>
+#include <vtkIdList.h>
+#include <vtkSmartPointer.h>
 
 VerticeEditorWidget::VerticeEditorWidget(QWidget *parent) :
     QDockWidget(parent),
@@ -44,7 +46,8 @@ VerticeEditorWidget::VerticeEditorWidget(QWidget *parent) :
 //    ui->tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
     ui->tableView->setSelectionMode(QAbstractItemView::SingleSelection);
 
-    connect(table,SIGNAL(pointEdited()),this,SLOT(slotPointChanged()));
+    connect(table,SIGNAL(pointEdited(vtkIdType,double,double,double)),
+            this,SLOT(slotPointChanged(vtkIdType,double,double,double)));
 
     connect(ui->scaleFactor,SIGNAL(editingFinished()),this,SLOT(slotSetScale()));
 
@@ -69,9 +72,15 @@ void VerticeEditorWidget::updateVertices()
     table->update();
 }
 
-void VerticeEditorWidget::slotPointChanged()
+void VerticeEditorWidget::slotPointChanged(vtkIdType id, double x, double y, double z)
 {
-    hexBlocker->rescaleActors();
+    //through hexBlocker so it can be undone
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    ids->InsertNextId(id);
+    double pos[3]={x,y,z};
+    bool setPos[3]={true,true,true};
+    hexBlocker->setVerticesPos(ids,pos,setPos);
+    table->update();
 }
 
 void VerticeEditorWidget::slotSetScale()
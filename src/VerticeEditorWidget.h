@@ -2,6 +2,7 @@
 #define VERTICEEDITORWIDGET_H
 
 #include <QDockWidget>
+#include <vtkType.h>
 
 //Predeclarations
 class HexBlocker;
@@ -23,7 +24,7 @@ public:
 
 public slots:
     void updateVertices();
-    void slotPointChanged();
+    void slotPointChanged(vtkIdType id, double x, double y, double z);
     void slotSetScale();
     void displayScale(double scale);
 
@@ -0,0 +1,150 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+/*
+  Times the model lists (HexCollection and the indexed edge and patch
+  lists) through HexBlocker on lattices of nx*ny*nz blocks, up to
+  maxBlocks blocks: looking up every edge and patch by its vertices,
+  the position of every block, and removing every second block with
+  removeHexBlocks. The time per block is constant if an operation is
+  linear in the size of the model.
+
+  usage: CollectionBenchmark [maxBlocks]
+*/
+
+#include "Lattice.h"
+#include "HexEdge.h"
+#include "HexPatch.h"
+
+#include <vtkTimerLog.h>
+
+#include <QCoreApplication>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+// findEdgeId for the vertices of every edge
+static double timeFindEdges(HexBlocker *hexBlocker)
+{
+    HexEdgeCollection *edges = hexBlocker->edges;
+    vtkIdType sum=0;
+    double t0 = vtkTimerLog::GetUniversalTime();
+    for(vtkIdType i=0;i<edges->GetNumberOfItems();i++)
+    {
+        HexEdge *e = HexEdge::SafeDownCast(edges->GetItemAsObject(i));
+        sum += edges->findEdgeId(e->vertIds->GetId(0),e->vertIds->GetId(1));
+    }
+    double t = vtkTimerLog::GetUniversalTime()-t0;
+    if(sum < 0)
+        std::cout << "an edge was not found" << std::endl;
+    return t;
+}
+
+// findPatchId for the vertices of every patch
+static double timeFindPatches(HexBlocker *hexBlocker)
+{
+    HexPatchCollection *patches = hexBlocker->patches;
+    vtkIdType sum=0;
+    double t0 = vtkTimerLog::GetUniversalTime();
+    for(vtkIdType i=0;i<patches->GetNumberOfItems();i++)
+    {
+        HexPatch *p = HexPatch::SafeDownCast(patches->GetItemAsObject(i));
+        sum += patches->findPatchId(p->vertIds);
+    }
+    double t = vtkTimerLog::GetUniversalTime()-t0;
+    if(sum < 0)
+        std::cout << "a patch was not found" << std::endl;
+    return t;
+}
+
+// IsItemPresent for every block
+static double timeBlockIds(HexBlocker *hexBlocker)
+{
+    HexCollection *blocks = hexBlocker->hexBlocks;
+    vtkIdType sum=0;
+    double t0 = vtkTimerLog::GetUniversalTime();
+    for(vtkIdType i=0;i<blocks->GetNumberOfItems();i++)
+        sum += blocks->IsItemPresent(blocks->GetItemAsObject(i));
+    double t = vtkTimerLog::GetUniversalTime()-t0;
+    if(sum <= 0)
+        std::cout << "a block was not found" << std::endl;
+    return t;
+}
+
+// removeHexBlocks of every second block
+static double timeRemoveBlocks(HexBlocker *hexBlocker)
+{
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    for(vtkIdType i=0;i<hexBlocker->hexBlocks->GetNumberOfItems();i+=2)
+        ids->InsertNextId(i);
+    double t0 = vtkTimerLog::GetUniversalTime();
+    hexBlocker->removeHexBlocks(ids);
+    return vtkTimerLog::GetUniversalTime()-t0;
+}
+
+static void printRow(const char *op, int n, double t)
+{
+    std::cout << std::setw(14) << op << std::setw(8) << n
+              << std::setw(14) << 1e3*t << std::setw(14) << 1e6*t/n
+              << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    //HexBlocker requests renders through a timer
+    QCoreApplication app(argc,argv);
+
+    int maxBlocks = 10000;
+    if(argc > 1)
+        maxBlocks = std::atoi(argv[1]);
+    if(maxBlocks < 8)
+    {
+        std::cout << "usage: " << argv[0] << " [maxBlocks]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::setw(14) << "operation" << std::setw(8) << "blocks"
+              << std::setw(14) << "ms" << std::setw(14) << "us/block"
+              << std::endl;
+
+    for(int n=maxBlocks/8;n<=maxBlocks;n*=2)
+    {
+        int nx,ny,nz;
+        latticeSize(n,nx,ny,nz);
+        HexBlocker *hexBlocker = new HexBlocker();
+        buildLattice(hexBlocker,nx,ny,nz);
+        int numBlocks = hexBlocker->hexBlocks->GetNumberOfItems();
+
+        printRow("find edges",numBlocks,timeFindEdges(hexBlocker));
+        printRow("find patches",numBlocks,timeFindPatches(hexBlocker));
+        printRow("block ids",numBlocks,timeBlockIds(hexBlocker));
+        printRow("remove blocks",numBlocks,timeRemoveBlocks(hexBlocker));
+
+        delete hexBlocker;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+
+Description
+    Generated models for the benchmarks.
+*/
+
+#ifndef LATTICE_H
+#define LATTICE_H
+
+#include "HexBlocker.h"
+#include "HexBlock.h"
+#include "HexCollection.h"
+#include "HexEdgeCollection.h"
+#include "HexPatchCollection.h"
+#include "HexReader.h"
+
+#include <vtkSmartPointer.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+
+#include <cmath>
+
+// the blocks of an nx*ny*nz lattice of unit cubes through a reader,
+// the same path as opening a file.
+inline void buildLattice(HexBlocker *hexBlocker, int nx, int ny, int nz)
+{
+    HexReader reader;
+    for(int k=0;k<=nz;k++)
+        for(int j=0;j<=ny;j++)
+            for(int i=0;i<=nx;i++)
+                reader.readVertices->InsertNextPoint(i,j,k);
+
+    //vertice (i,j,k)
+    int sx = nx+1, sxy = (nx+1)*(ny+1);
+    for(int k=0;k<nz;k++)
+        for(int j=0;j<ny;j++)
+            for(int i=0;i<nx;i++)
+            {
+                vtkIdType v0 = i + j*sx + k*sxy;
+                vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+                ids->SetNumberOfIds(8);
+                //bottom face then top face, counter clockwise
+                ids->SetId(0,v0);
+                ids->SetId(1,v0+1);
+                ids->SetId(2,v0+1+sx);
+                ids->SetId(3,v0+sx);
+                for(vtkIdType l=0;l<4;l++)
+                    ids->SetId(l+4,ids->GetId(l)+sxy);
+
+                vtkSmartPointer<HexBlock> b = vtkSmartPointer<HexBlock>::New();
+                b->init(ids,reader.readVertices,reader.readEdges,reader.readPatches);
+                reader.readBlocks->AddItem(b);
+            }
+
+    hexBlocker->readBlockMeshDict(&reader);
+}
+
+// nx*ny*nz close to n blocks, as close to a cube as possible
+inline void latticeSize(int n, int &nx, int &ny, int &nz)
+{
+    nx = int(std::pow(double(n),1.0/3.0)+0.5);
+    nx = nx < 1 ? 1 : nx;
+    ny = nx;
+    nz = n/(nx*ny);
+    nz = nz < 1 ? 1 : nz;
+}
+
+#endif // LATTICE_H
@@ -0,0 +1,242 @@
+/*
+Copyright 2012, 2013
+Author Nicolas Edh,
+Nicolas.Edh@gmail.com,
+or user "nsf" at cfd-online.com
+
+License
+    This file is part of hexBlocker.
+
+    hexBlocker is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    hexBlocker is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with hexBlocker.  If not, see <http://www.gnu.org/licenses/>.
+
+    The license is included in the file COPYING.
+*/
+
+/*
+  Times the model and its rendering on lattices of nx*ny*nz blocks,
+  from 10 up to maxBlocks blocks in steps of ten. For each size:
+  building the model (as when a blockMeshDict is read), the first
+  render, camera orbit frames, moving a vertex and redrawing, and
+  picking blocks, patches and edges. Rendering is offscreen, so with
+  VTK built against OSMesa it runs without a display.
+
+  Times are in milliseconds, one CSV row per size to csvFile or to
+  std::cout if none is given.
+
+  usage: RenderBenchmark [maxBlocks] [csvFile]
+*/
+
+#include "HexBlocker.h"
+#include "HexView.h"
+#include "HexBlock.h"
+#include "HexBlockRepresentation.h"
+#include "HexPatchRepresentation.h"
+#include "HexEdgeRepresentation.h"
+#include "HexCollection.h"
+#include "HexEdgeCollection.h"
+#include "HexPatchCollection.h"
+#include "Lattice.h"
+#include "HexRenderScheduler.h"
+
+#include <vtkSmartPointer.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkCamera.h>
+#include <vtkCellPicker.h>
+#include <vtkCellLocator.h>
+#include <vtkActor.h>
+#include <vtkTimerLog.h>
+
+#include <QCoreApplication>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+static const int numFrames = 36;
+static const int numMoves = 20;
+static const int numPicks = 50;
+
+// renders and collapses any render requested by the model
+static double timeRender(HexView *hexView)
+{
+    double t0 = vtkTimerLog::GetUniversalTime();
+    hexView->renderScheduler->renderNow();
+    return vtkTimerLog::GetUniversalTime()-t0;
+}
+
+// one turn around the model, returns seconds per frame
+static double timeOrbit(HexView *hexView)
+{
+    vtkCamera *cam = hexView->renderer->GetActiveCamera();
+    double t0 = vtkTimerLog::GetUniversalTime();
+    for(int i=0;i<numFrames;i++)
+    {
+        cam->Azimuth(360.0/numFrames);
+        hexView->renderScheduler->renderNow();
+    }
+    return (vtkTimerLog::GetUniversalTime()-t0)/numFrames;
+}
+
+// moves vertices spread over the model one at a time and renders
+// after each, returns seconds per move
+static double timeMoves(HexView *hexView)
+{
+    HexBlocker *hexBlocker = hexView->hexBlocker;
+    vtkIdType numVerts = hexBlocker->vertices->GetNumberOfPoints();
+    double dist[3] = {0.1,0.05,0.0};
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    double t0 = vtkTimerLog::GetUniversalTime();
+    for(int i=0;i<numMoves;i++)
+    {
+        ids->Reset();
+        ids->InsertNextId((i*numVerts)/numMoves);
+        hexBlocker->moveVertices(ids,dist);
+        hexView->renderScheduler->renderNow();
+    }
+    return (vtkTimerLog::GetUniversalTime()-t0)/numMoves;
+}
+
+// picks at points on a grid over the window, as the interactor style
+// does it, returns seconds per pick and the number of hits
+static double timePicks(HexView *hexView, vtkActor *actor, vtkCellLocator *locator,
+                        int &hits)
+{
+    int *size = hexView->renderer->GetRenderWindow()->GetSize();
+    vtkSmartPointer<vtkCellPicker> picker = vtkSmartPointer<vtkCellPicker>::New();
+    picker->SetTolerance(HexView::pickTolerance);
+    picker->AddPickList(actor);
+    picker->PickFromListOn();
+    picker->AddLocator(locator);
+
+    hits = 0;
+    double t0 = vtkTimerLog::GetUniversalTime();
+    for(int i=0;i<numPicks;i++)
+    {
+        double x = size[0]*(0.1 + 0.8*(i%10)/9.0);
+        double y = size[1]*(0.1 + 0.8*(i/10)/double(numPicks/10-1));
+        hits += picker->Pick(x,y,0.0,hexView->renderer);
+    }
+    double t = (vtkTimerLog::GetUniversalTime()-t0)/numPicks;
+    return t;
+}
+
+// seconds to (re)build a locator after the data has changed
+static double timeLocator(HexView *hexView, int type, vtkCellLocator **locator)
+{
+    double t0 = vtkTimerLog::GetUniversalTime();
+    switch(type)
+    {
+    case 0:
+        *locator = hexView->blockRep->getLocator();
+        break;
+    case 1:
+        *locator = hexView->patchRep->getLocator();
+        break;
+    default:
+        *locator = hexView->edgeRep->getLocator();
+        break;
+    }
+    return vtkTimerLog::GetUniversalTime()-t0;
+}
+
+int main(int argc, char **argv)
+{
+    //HexView requests renders through a timer
+    QCoreApplication app(argc,argv);
+
+    int maxBlocks = 100000;
+    if(argc > 1)
+        maxBlocks = std::atoi(argv[1]);
+    if(maxBlocks < 10)
+    {
+        std::cout << "usage: " << argv[0] << " [maxBlocks] [csvFile]" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if(argc > 2)
+    {
+        file.open(argv[2]);
+        if(!file)
+        {
+            std::cout << "could not open " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &os = file.is_open() ? file : std::cout;
+
+    os << "blocks,vertices,edges,patches,construct_ms,first_render_ms,"
+       << "orbit_frame_ms,move_ms,move_requests,"
+       << "block_locator_ms,block_pick_ms,block_hits,"
+       << "patch_locator_ms,patch_pick_ms,patch_hits,"
+       << "edge_locator_ms,edge_pick_ms,edge_hits" << std::endl;
+
+    for(int n=10;n<=maxBlocks;n*=10)
+    {
+        int nx,ny,nz;
+        latticeSize(n,nx,ny,nz);
+
+        HexBlocker *hexBlocker = new HexBlocker();
+        HexView *hexView = new HexView(hexBlocker);
+        vtkSmartPointer<vtkRenderWindow> renwin = vtkSmartPointer<vtkRenderWindow>::New();
+        renwin->SetOffScreenRendering(1);
+        renwin->SetSize(800,600);
+        renwin->AddRenderer(hexView->renderer);
+
+        double t0 = vtkTimerLog::GetUniversalTime();
+        buildLattice(hexBlocker,nx,ny,nz);
+        double tConstruct = vtkTimerLog::GetUniversalTime()-t0;
+
+        hexView->renderer->ResetCamera();
+        double tFirst = timeRender(hexView);
+        double tOrbit = timeOrbit(hexView);
+
+        hexView->renderScheduler->resetCounters();
+        double tMove = timeMoves(hexView);
+        int moveRequests = hexView->renderScheduler->numRequests;
+
+        //blocks, patches and edges are picked one type at a time
+        //as in InteractorStyleActorPick
+        vtkActor *actors[3] = {hexView->blockRep->actor,
+                               hexView->patchRep->actor,
+                               hexView->edgeRep->actor};
+        double tLocator[3], tPick[3];
+        int hits[3];
+        for(int i=0;i<3;i++)
+        {
+            vtkCellLocator *locator;
+            tLocator[i] = timeLocator(hexView,i,&locator);
+            tPick[i] = timePicks(hexView,actors[i],locator,hits[i]);
+        }
+
+        os << hexBlocker->hexBlocks->GetNumberOfItems() << ","
+           << hexBlocker->vertices->GetNumberOfPoints() << ","
+           << hexBlocker->edges->GetNumberOfItems() << ","
+           << hexBlocker->patches->GetNumberOfItems() << ","
+           << 1e3*tConstruct << "," << 1e3*tFirst << ","
+           << 1e3*tOrbit << "," << 1e3*tMove << "," << moveRequests;
+        for(int i=0;i<3;i++)
+            os << "," << 1e3*tLocator[i] << "," << 1e3*tPick[i]
+               << "," << hits[i];
+        os << std::endl;
+
+        renwin->RemoveRenderer(hexView->renderer);
+        delete hexView;
+        delete hexBlocker;
+    }
+
+    return 0;
+}
@@ -26,14 +26,41 @@ License
 
 #include <QApplication>
 #include <QCleanlooksStyle>
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
 #include "MainWindow.h"
+#include "HexBatch.h"
+#include "HexRenderScheduler.h"
 #include <iostream>
+#include <cstring>
 
 extern int qInitResources_icons();
 
 int main( int argc, char** argv )
 {
 
+  //hexBlocker -batch script [args], runs without any window
+  if(argc > 1 && strcmp(argv[1],"-batch") == 0)
+  {
+      if(argc < 3)
+      {
+          std::cerr << "usage: " << argv[0] << " -batch script [args]" << std::endl;
+          return 1;
+      }
+      QCoreApplication app( argc, argv );
+      QFile file(app.arguments().at(2));
+      if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+      {
+          std::cerr << "Error opening " << argv[2] << std::endl;
+          return 1;
+      }
+      QTextStream script(&file);
+      HexBatch batch;
+      return batch.run(script,app.arguments().mid(3));
+  }
+
   // QT Stuff
   QApplication app( argc, argv );
 
@@ -50,10 +77,16 @@ int main( int argc, char** argv )
   myMainWindow.setStyleSheet("QToolTip {background-color: black;}");
   myMainWindow.show();
 
+  //hexBlocker [-renderstats] [blockMeshDict], -renderstats prints
+  //the render counters of every user action, see HexRenderScheduler
+  QStringList args = app.arguments().mid(1);
+  if(args.removeAll("-renderstats") > 0)
+      HexRenderScheduler::setReportOperations(true);
+
   //Assume that a blockMeshDict is given on the commandline
-  if(argc > 1)
+  if(args.size() > 0)
   {
-      myMainWindow.openFileName = app.arguments().at(1);
+      myMainWindow.openFileName = args.at(0);
       myMainWindow.slotReOpenBlockMeshDict();
   }
   return app.exec();